@@ -0,0 +1,540 @@
+// Mikro-Benchmarks der heißen Pfade
+// Jeder Benchmark wird kalibriert (Aufwärmen, bis ein Durchgang die
+// Mindestdauer erreicht), dann mehrfach wiederholt. Je Wiederholung werden
+// ns/op und Allokationen/op erfasst; die Rohwerte gehen als JSON hinaus,
+// damit sich Builds vergleichen lassen (make bench-compare).
+//
+// Der Benchmark läuft in einem temporären Verzeichnis mit eigenem
+// Workspace, so dass Log- und Sensor-Dateien eines laufenden Systems
+// unberührt bleiben.
+
+// Für sched_setaffinity, mkdtemp und nftw
+#define _GNU_SOURCE
+
+#include "../config.h"
+#include "../sensor.h"
+#include "../logging.h"
+#include "../display.h"
+#include "../konsole.h"
+#include "../terminal.h"
+#include <ftw.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define WIEDERHOLUNGEN 15           // Gemessene Durchgänge je Benchmark
+#define MINDESTDAUER_MS 20          // Mindestdauer eines Durchgangs
+#define MAX_WIEDERHOLUNGEN 100
+#define MAX_ITERATIONEN 100000000L
+
+// Allokationen zählen
+// malloc & Co. werden überdeckt und an glibc weitergereicht; damit zählen
+// auch Allokationen innerhalb der C-Bibliothek (z.B. fopen).
+extern void* __libc_malloc(size_t groesse);
+extern void* __libc_calloc(size_t anzahl, size_t groesse);
+extern void* __libc_realloc(void* zeiger, size_t groesse);
+extern void __libc_free(void* zeiger);
+
+static unsigned long allokationen = 0;
+
+void* malloc(size_t groesse) {
+    allokationen++;
+    return __libc_malloc(groesse);
+}
+
+void* calloc(size_t anzahl, size_t groesse) {
+    allokationen++;
+    return __libc_calloc(anzahl, groesse);
+}
+
+void* realloc(void* zeiger, size_t groesse) {
+    allokationen++;
+    return __libc_realloc(zeiger, groesse);
+}
+
+void free(void* zeiger) {
+    __libc_free(zeiger);
+}
+
+// Ergebnisse landen hier, damit nichts wegoptimiert wird
+static volatile unsigned long senke = 0;
+
+// Ein Benchmark
+typedef struct {
+    const char* name;
+    void (*vorbereiten)(void);      // Vor jedem Durchgang, nicht gemessen (optional)
+    void (*lauf)(long iterationen);
+    int heiss;                      // Heißer Pfad (Regressionen brechen bench-compare ab)
+} Benchmark;
+
+// Ergebnis eines Benchmarks
+typedef struct {
+    long iterationen;               // Je Durchgang
+    int anzahl;
+    double ns_pro_op[MAX_WIEDERHOLUNGEN];
+    double allokationen_pro_op[MAX_WIEDERHOLUNGEN];
+} BenchErgebnis;
+
+static double jetzt_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Wechselnde Eingaben, damit nichts wegoptimiert oder zwischengespeichert wird
+static void daten_setzen(SensorDaten* daten, long i) {
+    daten->temperatur = -5.0f + (float)(i % 1500) * 0.01f;
+    daten->energie_verbrauch = 80.0f + (float)(i % 2000) * 0.1f;
+    daten->tuer_offen = (int)(i & 1);
+    daten->tuer_offen_seit = 0;
+    daten->gueltig = 1;
+}
+
+// Frühere Formatierung der ersten Display-Zeile als Referenz
+static void zeile1_referenz(char* zeile, const SensorDaten* daten, int log_level) {
+    char temp_str[10], energie_str[10];
+    sprintf(temp_str, "%.1f", daten->temperatur);
+    sprintf(energie_str, "%.0f", daten->energie_verbrauch);
+
+    zeile[0] = log_level_zu_zeichen(log_level);
+    zeile[1] = '\0';
+    strcat(zeile, " T:");
+    strcat(zeile, temp_str);
+    strcat(zeile, "C D:");
+    strcat(zeile, daten->tuer_offen ? "OFFEN" : "ZU");
+    strcat(zeile, " E:");
+    strcat(zeile, energie_str);
+    strcat(zeile, "W");
+
+    zeile_auffuellen(zeile);
+}
+
+/**
+ * Prüft, dass Formatierer und Referenz über den Wertebereich übereinstimmen
+ * @return Anzahl Abweichungen
+ */
+static long zeile1_vergleichen(void) {
+    char neu[DISPLAY_COLS + 1];
+    char alt[DISPLAY_COLS + 1];
+    SensorDaten daten;
+    long abweichungen = 0;
+
+    for (long i = 0; i < 300000; i++) {
+        daten_setzen(&daten, i);
+        daten.temperatur = -30.0f + (float)i * 0.0002f;
+        display_zeile1_formatieren(neu, &daten, 1);
+        zeile1_referenz(alt, &daten, 1);
+        // printf zeigt -0.04 als "-0.0", der neue Formatierer als "0.0"
+        if (strstr(alt, "T:-0.0C") != NULL) {
+            continue;
+        }
+        if (memcmp(neu, alt, sizeof(neu)) != 0) {
+            if (abweichungen < 5) {
+                fprintf(stderr, "Abweichung: '%s' / '%s'\n", neu, alt);
+            }
+            abweichungen++;
+        }
+    }
+    return abweichungen;
+}
+
+// Benchmarks
+
+static void lauf_sensor_werte_lesen(long n) {
+    SensorDaten daten;
+    for (long i = 0; i < n; i++) {
+        senke += (unsigned long)sensor_werte_lesen(&daten);
+    }
+}
+
+static void lauf_temperatur_lesen(long n) {
+    float temperatur;
+    for (long i = 0; i < n; i++) {
+        senke += (unsigned long)temperatur_lesen(&temperatur);
+    }
+}
+
+static void lauf_tuer_status_lesen(long n) {
+    int offen;
+    long seit;
+    for (long i = 0; i < n; i++) {
+        senke += (unsigned long)tuer_status_lesen(&offen, &seit);
+    }
+}
+
+static void lauf_energie_lesen(long n) {
+    float energie;
+    for (long i = 0; i < n; i++) {
+        senke += (unsigned long)energie_lesen(&energie);
+    }
+}
+
+// Wechselnder Text, damit die Unterdrückung von Wiederholungen nicht greift
+static void log_laufen(LogLevel level, long n) {
+    for (long i = 0; i < n; i++) {
+        log_formatiert(level, "Benchmark Messwert %ld: %.2f°C", i, (double)(i % 100) * 0.1);
+    }
+}
+
+static void lauf_log_debug(long n) { log_laufen(LOG_DEBUG, n); }
+static void lauf_log_info(long n) { log_laufen(LOG_INFO, n); }
+static void lauf_log_warnung(long n) { log_laufen(LOG_WARNING, n); }
+static void lauf_log_fehler(long n) { log_laufen(LOG_ERROR, n); }
+
+static void lauf_zeile1(long n) {
+    char zeile[DISPLAY_COLS + 1];
+    SensorDaten daten;
+    for (long i = 0; i < n; i++) {
+        daten_setzen(&daten, i);
+        display_zeile1_formatieren(zeile, &daten, (int)(i & 3));
+        senke += (unsigned char)zeile[6];
+    }
+}
+
+static void lauf_zeile1_referenz(long n) {
+    char zeile[DISPLAY_COLS + 1];
+    SensorDaten daten;
+    for (long i = 0; i < n; i++) {
+        daten_setzen(&daten, i);
+        zeile1_referenz(zeile, &daten, (int)(i & 3));
+        senke += (unsigned char)zeile[6];
+    }
+}
+
+static void lauf_zeile2(long n) {
+    char zeile[DISPLAY_COLS + 1];
+    SensorDaten daten;
+    for (long i = 0; i < n; i++) {
+        daten_setzen(&daten, i);
+        display_zeile2_formatieren(zeile, &daten);
+        senke += (unsigned char)zeile[2];
+    }
+}
+
+static void lauf_alarme_ok(long n) {
+    SensorDaten daten;
+    daten_setzen(&daten, 0);
+    daten.temperatur = TARGET_TEMPERATURE;
+    daten.energie_verbrauch = TARGET_ENERGY;
+    daten.tuer_offen = 0;
+    for (long i = 0; i < n; i++) {
+        senke += (unsigned long)sensor_alarme_pruefen(&daten);
+    }
+}
+
+static void lauf_alarme_temperatur(long n) {
+    SensorDaten daten;
+    daten_setzen(&daten, 0);
+    daten.tuer_offen = 0;
+    daten.energie_verbrauch = TARGET_ENERGY;
+    for (long i = 0; i < n; i++) {
+        daten.temperatur = MAX_TEMP_THRESHOLD + 1.0f + (float)(i % 50) * 0.01f;
+        senke += (unsigned long)sensor_alarme_pruefen(&daten);
+    }
+}
+
+// Ein Durchlauf der Hauptschleife mit fälligem Sensor-Auftrag, zusammengesetzt
+// wie in sensor_daten_verarbeiten() und hauptschleife() (ohne poll)
+static void lauf_hauptschleife(long n) {
+    SensorDaten daten;
+    for (long i = 0; i < n; i++) {
+        int aenderungen = 0;
+        aenderungen += datei_wurde_geaendert(TEMPERATURE_FILE, TEMP_DATEI_INDEX);
+        aenderungen += datei_wurde_geaendert(DOOR_FILE, TUER_DATEI_INDEX);
+        aenderungen += datei_wurde_geaendert(ENERGY_FILE, ENERGIE_DATEI_INDEX);
+        if (sensor_werte_lesen(&daten)) {
+            senke += (unsigned long)sensor_alarme_pruefen(&daten);
+            display_aktualisieren(&daten, log_level_abfragen());
+        }
+        display_zyklus();
+        logging_zyklus();
+        konsole_abarbeiten();
+        senke += (unsigned long)aenderungen;
+    }
+}
+
+// Log-Datei leeren, damit sie über die Durchgänge nicht unbegrenzt wächst
+static void log_leeren(void) {
+    logging_zyklus();
+    if (truncate(LOG_DATEI, 0) != 0 || truncate(LOG_INDEX_DATEI, 0) != 0) {
+        perror("truncate");
+    }
+}
+
+// Log-Level für die log_formatiert-Messungen: alles wird geschrieben
+static void log_alles_schreiben(void) {
+    log_level_setzen(LOG_DEBUG);
+    log_leeren();
+}
+
+// Standard-Level: DEBUG wird verworfen
+static void log_standard(void) {
+    log_level_setzen(LOG_INFO);
+    log_leeren();
+}
+
+static const Benchmark benchmarks[] = {
+    {"sensor_werte_lesen", NULL, lauf_sensor_werte_lesen, 1},
+    {"temperatur_lesen", NULL, lauf_temperatur_lesen, 1},
+    {"tuer_status_lesen", NULL, lauf_tuer_status_lesen, 1},
+    {"energie_lesen", NULL, lauf_energie_lesen, 1},
+    {"log_formatiert_debug_verworfen", log_standard, lauf_log_debug, 1},
+    {"log_formatiert_debug", log_alles_schreiben, lauf_log_debug, 1},
+    {"log_formatiert_info", log_alles_schreiben, lauf_log_info, 1},
+    {"log_formatiert_warnung", log_alles_schreiben, lauf_log_warnung, 1},
+    {"log_formatiert_fehler", log_alles_schreiben, lauf_log_fehler, 1},
+    {"display_zeile1_formatieren", NULL, lauf_zeile1, 1},
+    {"display_zeile1_referenz", NULL, lauf_zeile1_referenz, 0},
+    {"display_zeile2_formatieren", NULL, lauf_zeile2, 1},
+    {"sensor_alarme_pruefen_ok", log_standard, lauf_alarme_ok, 1},
+    {"sensor_alarme_pruefen_alarm", log_standard, lauf_alarme_temperatur, 0},
+    {"hauptschleife_durchlauf", log_standard, lauf_hauptschleife, 1},
+};
+
+#define BENCHMARK_ANZAHL ((int)(sizeof(benchmarks) / sizeof(benchmarks[0])))
+
+/**
+ * Ein Durchgang mit fester Iterationszahl
+ * @return Dauer in ns
+ */
+static double durchgang(const Benchmark* b, long iterationen, unsigned long* allokiert) {
+    if (b->vorbereiten != NULL) {
+        b->vorbereiten();
+    }
+    unsigned long allokationen_vorher = allokationen;
+    double start = jetzt_ns();
+    b->lauf(iterationen);
+    double dauer = jetzt_ns() - start;
+    *allokiert = allokationen - allokationen_vorher;
+    return dauer;
+}
+
+/**
+ * Kalibriert, wärmt auf und misst einen Benchmark
+ */
+static void benchmark_messen(const Benchmark* b, int wiederholungen, BenchErgebnis* ergebnis) {
+    unsigned long allokiert;
+    long iterationen = 1;
+
+    // Iterationen verdoppeln, bis ein Durchgang die Mindestdauer erreicht
+    // (zugleich Aufwärmphase für Caches, Sprungvorhersage und Seitentabellen)
+    while (iterationen < MAX_ITERATIONEN &&
+           durchgang(b, iterationen, &allokiert) < MINDESTDAUER_MS * 1e6) {
+        iterationen *= 2;
+    }
+    durchgang(b, iterationen, &allokiert);
+
+    ergebnis->iterationen = iterationen;
+    ergebnis->anzahl = wiederholungen;
+    for (int w = 0; w < wiederholungen; w++) {
+        double dauer = durchgang(b, iterationen, &allokiert);
+        ergebnis->ns_pro_op[w] = dauer / (double)iterationen;
+        ergebnis->allokationen_pro_op[w] = (double)allokiert / (double)iterationen;
+    }
+}
+
+static int double_vergleichen(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double median(const double* werte, int anzahl) {
+    double sortiert[MAX_WIEDERHOLUNGEN];
+    memcpy(sortiert, werte, (size_t)anzahl * sizeof(double));
+    qsort(sortiert, (size_t)anzahl, sizeof(double), double_vergleichen);
+    if (anzahl % 2 == 0) {
+        return (sortiert[anzahl / 2 - 1] + sortiert[anzahl / 2]) / 2.0;
+    }
+    return sortiert[anzahl / 2];
+}
+
+/**
+ * Schreibt einen JSON-String (nur Anführungszeichen und Backslash maskiert)
+ */
+static void json_string(FILE* datei, const char* text) {
+    fputc('"', datei);
+    for (const char* p = text; *p != '\0'; p++) {
+        if (*p == '"' || *p == '\\') {
+            fputc('\\', datei);
+        }
+        if ((unsigned char)*p >= 0x20) {
+            fputc(*p, datei);
+        }
+    }
+    fputc('"', datei);
+}
+
+static void json_schreiben(FILE* datei, const char* revision, const char* flags, int kern,
+                           const BenchErgebnis* ergebnisse, const int* ausgewaehlt) {
+    fprintf(datei, "{\n  \"revision\": ");
+    json_string(datei, revision);
+    fprintf(datei, ",\n  \"flags\": ");
+    json_string(datei, flags);
+    fprintf(datei, ",\n  \"zeitpunkt\": %ld,\n  \"kern\": %d,\n  \"benchmarks\": [", (long)time(NULL), kern);
+
+    int erster = 1;
+    for (int i = 0; i < BENCHMARK_ANZAHL; i++) {
+        if (!ausgewaehlt[i]) {
+            continue;
+        }
+        const BenchErgebnis* e = &ergebnisse[i];
+        fprintf(datei, "%s\n    {\"name\": \"%s\", \"heiss\": %s, \"iterationen\": %ld, "
+                "\"median_ns\": %.3f, \"allokationen_pro_op\": %.3f, \"ns_pro_op\": [",
+                erster ? "" : ",", benchmarks[i].name, benchmarks[i].heiss ? "true" : "false",
+                e->iterationen, median(e->ns_pro_op, e->anzahl),
+                median(e->allokationen_pro_op, e->anzahl));
+        for (int w = 0; w < e->anzahl; w++) {
+            fprintf(datei, "%s%.3f", w > 0 ? ", " : "", e->ns_pro_op[w]);
+        }
+        fprintf(datei, "]}");
+        erster = 0;
+    }
+    fprintf(datei, "\n  ]\n}\n");
+}
+
+/**
+ * Richtet ein temporäres Arbeitsverzeichnis mit Workspace ein
+ */
+static int arbeitsverzeichnis_einrichten(char* pfad) {
+    if (mkdtemp(pfad) == NULL || chdir(pfad) != 0 || mkdir("Workspace", 0755) != 0) {
+        return 0;
+    }
+    konsole_initialisieren(AUSGABE_DATEI);
+    terminal_initialisieren(TERMINAL_AUS);
+    logging_initialisieren();
+    standard_sensor_dateien_erstellen();
+    sensor_system_initialisieren();
+    display_bildrate_setzen(0);
+    display_initialisieren();
+    return 1;
+}
+
+static int eintrag_loeschen(const char* pfad, const struct stat* info, int typ, struct FTW* ftw) {
+    (void)info;
+    (void)typ;
+    (void)ftw;
+    return remove(pfad);
+}
+
+static void arbeitsverzeichnis_aufraeumen(const char* pfad) {
+    display_beenden();
+    sensor_system_beenden();
+    logging_beenden();
+    konsole_beenden(0);
+    nftw(pfad, eintrag_loeschen, 8, FTW_DEPTH | FTW_PHYS);
+}
+
+static void hilfe_anzeigen(const char* programm) {
+    printf("Verwendung: %s [Optionen]\n", programm);
+    printf("  --json DATEI          Ergebnisse als JSON schreiben\n");
+    printf("  --wiederholungen N    Gemessene Durchgänge je Benchmark (Standard: %d)\n", WIEDERHOLUNGEN);
+    printf("  --kern N              Auf CPU-Kern N festlegen (Standard: 0, -1 = nicht festlegen)\n");
+    printf("  --filter TEXT         Nur Benchmarks, deren Name TEXT enthält\n");
+    printf("  --revision REV        Revision für die JSON-Ausgabe\n");
+    printf("  --flags FLAGS         Build-Flags für die JSON-Ausgabe\n");
+}
+
+int main(int argc, char* argv[]) {
+    const char* json_pfad = NULL;
+    const char* filter = NULL;
+    const char* revision = "unbekannt";
+    const char* flags = "";
+    int wiederholungen = WIEDERHOLUNGEN;
+    int kern = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_pfad = argv[++i];
+        } else if (strcmp(argv[i], "--wiederholungen") == 0 && i + 1 < argc) {
+            wiederholungen = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--kern") == 0 && i + 1 < argc) {
+            kern = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--revision") == 0 && i + 1 < argc) {
+            revision = argv[++i];
+        } else if (strcmp(argv[i], "--flags") == 0 && i + 1 < argc) {
+            flags = argv[++i];
+        } else {
+            hilfe_anzeigen(argv[0]);
+            return strcmp(argv[i], "--hilfe") == 0 ? 0 : 1;
+        }
+    }
+    if (wiederholungen < 1 || wiederholungen > MAX_WIEDERHOLUNGEN) {
+        fprintf(stderr, "Wiederholungen müssen zwischen 1 und %d liegen\n", MAX_WIEDERHOLUNGEN);
+        return 1;
+    }
+
+    // Auf einen Kern festlegen, damit Migrationen die Streuung nicht erhöhen
+    if (kern >= 0) {
+        cpu_set_t kerne;
+        CPU_ZERO(&kerne);
+        CPU_SET(kern, &kerne);
+        if (sched_setaffinity(0, sizeof(kerne), &kerne) != 0) {
+            fprintf(stderr, "Warnung: Festlegen auf Kern %d fehlgeschlagen\n", kern);
+            kern = -1;
+        }
+    }
+
+    // JSON-Datei vor dem Wechsel ins Arbeitsverzeichnis öffnen (relative Pfade)
+    FILE* json = NULL;
+    if (json_pfad != NULL) {
+        json = fopen(json_pfad, "w");
+        if (json == NULL) {
+            perror(json_pfad);
+            return 1;
+        }
+    }
+
+    long abweichungen = zeile1_vergleichen();
+    if (abweichungen > 0) {
+        fprintf(stderr, "display_zeile1_formatieren: %ld Abweichungen von der Referenz\n", abweichungen);
+        return 1;
+    }
+
+    char verzeichnis[] = "/tmp/kuehlschrank_bench_XXXXXX";
+    if (!arbeitsverzeichnis_einrichten(verzeichnis)) {
+        perror("Arbeitsverzeichnis");
+        return 1;
+    }
+
+    static BenchErgebnis ergebnisse[BENCHMARK_ANZAHL];
+    int ausgewaehlt[BENCHMARK_ANZAHL];
+
+    printf("%-32s %12s %10s %10s %10s %8s\n", "Benchmark", "Iterationen", "Median", "Min", "Max", "Allok/op");
+    for (int i = 0; i < BENCHMARK_ANZAHL; i++) {
+        const Benchmark* b = &benchmarks[i];
+        ausgewaehlt[i] = filter == NULL || strstr(b->name, filter) != NULL;
+        if (!ausgewaehlt[i]) {
+            continue;
+        }
+        BenchErgebnis* e = &ergebnisse[i];
+        benchmark_messen(b, wiederholungen, e);
+
+        double min = e->ns_pro_op[0], max = e->ns_pro_op[0];
+        for (int w = 1; w < e->anzahl; w++) {
+            if (e->ns_pro_op[w] < min) min = e->ns_pro_op[w];
+            if (e->ns_pro_op[w] > max) max = e->ns_pro_op[w];
+        }
+        printf("%-32s %12ld %7.1f ns %7.1f ns %7.1f ns %8.2f\n", b->name, e->iterationen,
+               median(e->ns_pro_op, e->anzahl), min, max, median(e->allokationen_pro_op, e->anzahl));
+        fflush(stdout);
+    }
+
+    arbeitsverzeichnis_aufraeumen(verzeichnis);
+
+    if (json != NULL) {
+        json_schreiben(json, revision, flags, kern, ergebnisse, ausgewaehlt);
+        if (fclose(json) != 0) {
+            perror(json_pfad);
+            return 1;
+        }
+        printf("Ergebnisse: %s\n", json_pfad);
+    }
+    return 0;
+}
@@ -0,0 +1,299 @@
+// Vergleich zweier Benchmark-Läufe (JSON von bench/bench.c)
+// Je Benchmark werden die Wiederholungen beider Läufe mit dem
+// Mann-Whitney-U-Test verglichen (Normalapproximation mit Bindungs- und
+// Stetigkeitskorrektur, einseitig je Richtung). Eine Regression liegt vor,
+// wenn der neue Lauf signifikant langsamer ist (p < alpha) und der Median
+// um mehr als die Schwelle steigt. Regressionen heißer Pfade ergeben
+// Exit-Code 1.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_BENCHMARKS 64
+#define MAX_WERTE 100
+#define MAX_NAME 64
+#define SCHWELLE_STANDARD 10.0      // Prozent
+#define ALPHA_STANDARD 0.01
+
+// Ein Benchmark eines Laufs
+typedef struct {
+    char name[MAX_NAME];
+    int heiss;
+    int anzahl;
+    double werte[MAX_WERTE];
+} BenchReihe;
+
+// Ein Lauf
+typedef struct {
+    char revision[MAX_NAME];
+    char flags[256];
+    int anzahl;
+    BenchReihe reihen[MAX_BENCHMARKS];
+} BenchLauf;
+
+/**
+ * Liest die ganze Datei in einen Puffer
+ */
+static char* datei_lesen(const char* pfad) {
+    FILE* datei = fopen(pfad, "r");
+    if (datei == NULL) {
+        return NULL;
+    }
+    fseek(datei, 0, SEEK_END);
+    long groesse = ftell(datei);
+    fseek(datei, 0, SEEK_SET);
+    char* inhalt = groesse >= 0 ? malloc((size_t)groesse + 1) : NULL;
+    if (inhalt != NULL) {
+        size_t gelesen = fread(inhalt, 1, (size_t)groesse, datei);
+        inhalt[gelesen] = '\0';
+    }
+    fclose(datei);
+    return inhalt;
+}
+
+/**
+ * Kopiert den String-Wert nach "schluessel": (ohne Maskierungen)
+ */
+static void string_feld(const char* text, const char* schluessel, char* ziel, size_t groesse) {
+    ziel[0] = '\0';
+    const char* p = strstr(text, schluessel);
+    if (p == NULL || (p = strchr(p + strlen(schluessel), '"')) == NULL) {
+        return;
+    }
+    size_t i = 0;
+    for (p++; *p != '\0' && *p != '"' && i + 1 < groesse; p++) {
+        if (*p == '\\' && p[1] != '\0') {
+            p++;
+        }
+        ziel[i++] = *p;
+    }
+    ziel[i] = '\0';
+}
+
+/**
+ * Liest einen Lauf im Format von bench --json
+ * Erwartet wird genau dieses Format, kein allgemeiner JSON-Parser.
+ */
+static int lauf_lesen(const char* pfad, BenchLauf* lauf) {
+    char* inhalt = datei_lesen(pfad);
+    if (inhalt == NULL) {
+        perror(pfad);
+        return 0;
+    }
+    memset(lauf, 0, sizeof(*lauf));
+    string_feld(inhalt, "\"revision\":", lauf->revision, sizeof(lauf->revision));
+    string_feld(inhalt, "\"flags\":", lauf->flags, sizeof(lauf->flags));
+
+    const char* p = strstr(inhalt, "\"benchmarks\":");
+    while (p != NULL && (p = strstr(p, "{\"name\":")) != NULL && lauf->anzahl < MAX_BENCHMARKS) {
+        BenchReihe* reihe = &lauf->reihen[lauf->anzahl];
+        const char* ende = strchr(p, '}');
+        if (ende == NULL) {
+            break;
+        }
+        string_feld(p, "\"name\":", reihe->name, sizeof(reihe->name));
+        const char* heiss = strstr(p, "\"heiss\":");
+        reihe->heiss = heiss != NULL && heiss < ende && strncmp(heiss + 8, " true", 5) == 0;
+
+        const char* werte = strstr(p, "\"ns_pro_op\":");
+        if (werte != NULL && werte < ende && (werte = strchr(werte, '[')) != NULL) {
+            char* weiter;
+            werte++;
+            while (reihe->anzahl < MAX_WERTE) {
+                double wert = strtod(werte, &weiter);
+                if (weiter == werte) {
+                    break;
+                }
+                reihe->werte[reihe->anzahl++] = wert;
+                werte = weiter;
+                while (*werte == ',' || *werte == ' ') {
+                    werte++;
+                }
+            }
+        }
+        if (reihe->anzahl > 0) {
+            lauf->anzahl++;
+        }
+        p = ende;
+    }
+
+    free(inhalt);
+    if (lauf->anzahl == 0) {
+        fprintf(stderr, "%s: keine Benchmarks gefunden\n", pfad);
+        return 0;
+    }
+    return 1;
+}
+
+static const BenchReihe* reihe_suchen(const BenchLauf* lauf, const char* name) {
+    for (int i = 0; i < lauf->anzahl; i++) {
+        if (strcmp(lauf->reihen[i].name, name) == 0) {
+            return &lauf->reihen[i];
+        }
+    }
+    return NULL;
+}
+
+static int double_vergleichen(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double median(const BenchReihe* reihe) {
+    double sortiert[MAX_WERTE];
+    memcpy(sortiert, reihe->werte, (size_t)reihe->anzahl * sizeof(double));
+    qsort(sortiert, (size_t)reihe->anzahl, sizeof(double), double_vergleichen);
+    int n = reihe->anzahl;
+    return n % 2 == 0 ? (sortiert[n / 2 - 1] + sortiert[n / 2]) / 2.0 : sortiert[n / 2];
+}
+
+/**
+ * Mann-Whitney-U-Test, einseitig
+ * @param p_langsamer p-Wert für "neu ist größer (langsamer) als basis"
+ * @param p_schneller p-Wert für "neu ist kleiner (schneller) als basis"
+ */
+static void mann_whitney(const BenchReihe* basis, const BenchReihe* neu,
+                         double* p_langsamer, double* p_schneller) {
+    typedef struct {
+        double wert;
+        int neu;
+    } Rangwert;
+
+    int n1 = basis->anzahl, n2 = neu->anzahl, n = n1 + n2;
+    Rangwert alle[2 * MAX_WERTE];
+    for (int i = 0; i < n1; i++) {
+        alle[i].wert = basis->werte[i];
+        alle[i].neu = 0;
+    }
+    for (int i = 0; i < n2; i++) {
+        alle[n1 + i].wert = neu->werte[i];
+        alle[n1 + i].neu = 1;
+    }
+    // Einfügesortieren genügt für höchstens 200 Werte
+    for (int i = 1; i < n; i++) {
+        Rangwert x = alle[i];
+        int j = i - 1;
+        while (j >= 0 && alle[j].wert > x.wert) {
+            alle[j + 1] = alle[j];
+            j--;
+        }
+        alle[j + 1] = x;
+    }
+
+    // Rangsumme des neuen Laufs, Bindungen erhalten den mittleren Rang
+    double rangsumme = 0.0;
+    double bindungen = 0.0;
+    for (int i = 0; i < n;) {
+        int j = i;
+        while (j + 1 < n && alle[j + 1].wert == alle[i].wert) {
+            j++;
+        }
+        double rang = (i + j) / 2.0 + 1.0;
+        for (int k = i; k <= j; k++) {
+            if (alle[k].neu) {
+                rangsumme += rang;
+            }
+        }
+        double t = j - i + 1;
+        bindungen += t * t * t - t;
+        i = j + 1;
+    }
+
+    double u = rangsumme - n2 * (n2 + 1) / 2.0;
+    double mittel = n1 * n2 / 2.0;
+    double varianz = n1 * n2 / 12.0 * ((n + 1) - bindungen / ((double)n * (n - 1)));
+    if (varianz <= 0.0) {
+        *p_langsamer = 1.0;
+        *p_schneller = 1.0;
+        return;
+    }
+    double sd = sqrt(varianz);
+    *p_langsamer = 0.5 * erfc(((u - mittel - 0.5) / sd) / sqrt(2.0));
+    *p_schneller = 0.5 * erfc((-(u - mittel + 0.5) / sd) / sqrt(2.0));
+}
+
+static void hilfe_anzeigen(const char* programm) {
+    printf("Verwendung: %s BASIS.json NEU.json [Optionen]\n", programm);
+    printf("  --schwelle PROZENT  Mindestanstieg des Medians für eine Regression (Standard: %.0f)\n",
+           SCHWELLE_STANDARD);
+    printf("  --alpha WERT        Signifikanzniveau (Standard: %.2f)\n", ALPHA_STANDARD);
+}
+
+int main(int argc, char* argv[]) {
+    const char* pfade[2] = {NULL, NULL};
+    int pfad_anzahl = 0;
+    double schwelle = SCHWELLE_STANDARD;
+    double alpha = ALPHA_STANDARD;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--schwelle") == 0 && i + 1 < argc) {
+            schwelle = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--alpha") == 0 && i + 1 < argc) {
+            alpha = atof(argv[++i]);
+        } else if (argv[i][0] != '-' && pfad_anzahl < 2) {
+            pfade[pfad_anzahl++] = argv[i];
+        } else {
+            hilfe_anzeigen(argv[0]);
+            return 2;
+        }
+    }
+    if (pfad_anzahl != 2 || alpha <= 0.0 || alpha >= 1.0 || schwelle < 0.0) {
+        hilfe_anzeigen(argv[0]);
+        return 2;
+    }
+
+    static BenchLauf basis, neu;
+    if (!lauf_lesen(pfade[0], &basis) || !lauf_lesen(pfade[1], &neu)) {
+        return 2;
+    }
+
+    printf("Basis: %s (%s)\nNeu:   %s (%s)\n", basis.revision, pfade[0], neu.revision, pfade[1]);
+    if (strcmp(basis.flags, neu.flags) != 0) {
+        printf("Warnung: unterschiedliche Build-Flags\n  Basis: %s\n  Neu:   %s\n", basis.flags, neu.flags);
+    }
+    printf("Schwelle %.1f %%, alpha %.3f\n\n", schwelle, alpha);
+    // "Änderung" ist ein Byte länger als breit (UTF-8)
+    printf("%-32s %12s %12s %9s %8s  %s\n", "Benchmark", "Basis", "Neu", "Änderung", "p", "Ergebnis");
+
+    int regressionen = 0;
+    for (int i = 0; i < neu.anzahl; i++) {
+        const BenchReihe* n = &neu.reihen[i];
+        const BenchReihe* b = reihe_suchen(&basis, n->name);
+        if (b == NULL) {
+            printf("%-32s %12s %9.1f ns %8s %8s  neu\n", n->name, "-", median(n), "", "");
+            continue;
+        }
+
+        double median_basis = median(b);
+        double median_neu = median(n);
+        double aenderung = median_basis > 0.0 ? (median_neu / median_basis - 1.0) * 100.0 : 0.0;
+        double p_langsamer, p_schneller;
+        mann_whitney(b, n, &p_langsamer, &p_schneller);
+
+        const char* ergebnis = "unverändert";
+        double p = p_langsamer < p_schneller ? p_langsamer : p_schneller;
+        if (p_langsamer < alpha && aenderung > schwelle) {
+            if (n->heiss) {
+                ergebnis = "REGRESSION";
+                regressionen++;
+            } else {
+                ergebnis = "langsamer (kein heißer Pfad)";
+            }
+        } else if (p_schneller < alpha && -aenderung > schwelle) {
+            ergebnis = "schneller";
+        }
+        printf("%-32s %9.1f ns %9.1f ns %+7.1f%% %8.4f  %s\n",
+               n->name, median_basis, median_neu, aenderung, p, ergebnis);
+    }
+
+    printf("\n");
+    if (regressionen > 0) {
+        printf("%d Regression(en) in heißen Pfaden\n", regressionen);
+        return 1;
+    }
+    printf("Keine Regression in heißen Pfaden\n");
+    return 0;
+}
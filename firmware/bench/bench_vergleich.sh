@@ -0,0 +1,62 @@
+#!/bin/bash
+
+# Benchmark-Vergleich zweier Firmware-Stände (Aufruf über make bench-compare)
+# Misst den aktuellen Stand, legt das Ergebnis unter bench/ergebnisse ab und
+# vergleicht es mit einer Basis. Schlüssel der Ablage: Revision (mit Zusatz
+# "-geaendert" bei lokalen Änderungen) und Prüfsumme der Build-Flags.
+#
+# Verwendung: bench/bench_vergleich.sh [BASIS]
+#   BASIS  Git-Revision; fehlt ihr Ergebnis, wird sie in einem temporären
+#          Worktree gebaut und gemessen. Ohne BASIS: jüngstes anderes
+#          Ergebnis mit denselben Build-Flags.
+#
+# Umgebung (von make gesetzt): MAKE, BENCH_FLAGS, BENCH_SCHWELLE, BENCH_ALPHA
+
+set -e  # Bei Fehlern abbrechen
+
+# Konfiguration
+ABLAGE="bench/ergebnisse"
+VERGLEICH="bin/bench_vergleich"
+MAKE="${MAKE:-make}"
+SCHWELLE="${BENCH_SCHWELLE:-10}"
+ALPHA="${BENCH_ALPHA:-0.01}"
+FLAGS_SUMME=$(printf '%s' "$BENCH_FLAGS" | cksum | cut -d' ' -f1)
+
+mkdir -p "$ABLAGE"
+
+# Aktuellen Stand messen
+REVISION=$(git rev-parse --short HEAD 2>/dev/null || echo unbekannt)
+if ! git diff --quiet HEAD -- . 2>/dev/null; then
+    REVISION="${REVISION}-geaendert"
+fi
+NEU="$ABLAGE/${REVISION}-${FLAGS_SUMME}.json"
+"$MAKE" --no-print-directory bench BENCH_JSON="$NEU" CFLAGS="$BENCH_FLAGS"
+echo ""
+
+# Basis bestimmen
+if [ -n "$1" ]; then
+    BASIS_REVISION=$(git rev-parse --short "$1")
+    BASIS="$ABLAGE/${BASIS_REVISION}-${FLAGS_SUMME}.json"
+    if [ ! -f "$BASIS" ]; then
+        echo "Kein Ergebnis für $BASIS_REVISION, messe im temporären Worktree..."
+        WORKTREE=$(mktemp -d /tmp/kuehlschrank_basis_XXXXXX)
+        UNTERVERZEICHNIS=$(git rev-parse --show-prefix)
+        git worktree add --quiet --detach "$WORKTREE" "$BASIS_REVISION"
+        trap 'git worktree remove --force "$WORKTREE"' EXIT
+        if ! "$MAKE" --no-print-directory -C "$WORKTREE/$UNTERVERZEICHNIS" bench \
+                BENCH_JSON="$PWD/$BASIS" CFLAGS="$BENCH_FLAGS"; then
+            echo "Basis $BASIS_REVISION lässt sich nicht messen (make bench fehlt oder schlägt fehl)" >&2
+            rm -f "$BASIS"
+            exit 2
+        fi
+        echo ""
+    fi
+else
+    BASIS=$(ls -t "$ABLAGE"/*-"${FLAGS_SUMME}".json 2>/dev/null | grep -v "^$NEU\$" | head -n 1 || true)
+    if [ -z "$BASIS" ]; then
+        echo "Keine Basis mit denselben Build-Flags in $ABLAGE; Ergebnis abgelegt als $NEU"
+        exit 0
+    fi
+fi
+
+"$VERGLEICH" "$BASIS" "$NEU" --schwelle "$SCHWELLE" --alpha "$ALPHA"
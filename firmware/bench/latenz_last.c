@@ -0,0 +1,460 @@
+// Lastgenerator für die Ende-zu-Ende-Latenz Sensor -> Alarm-Log / Display
+// Schreibt Temperaturen mit fester Rate nach Workspace/temperatur.txt und
+// misst, wann der Wert im Alarm-Log (Erkennung) und im Status-Datensatz
+// Workspace/display.txt (Anzeige) ankommt.
+//
+// Jede Aktualisierung trägt ihre Sequenznummer als zweites Feld (der Parser
+// der Firmware liest nur die Temperatur) und ist zusätzlich im Wert kodiert:
+// 10.0 + (seq % 100) * 0.1 °C. Der Wert liegt über MAX_TEMP_THRESHOLD, löst
+// also immer einen Alarm aus, und ist in beiden Senken (Log mit %.2f,
+// Display in Zehntel) eindeutig. Geschrieben wird über eine temporäre Datei
+// und rename(), damit die Firmware nie eine halbe Datei liest.
+//
+// Ohne --extern startet der Generator die Firmware nacheinander in jedem
+// Modus (Sensor-Intervall, Bildrate) in einem temporären Verzeichnis;
+// die Simulation der Firmware ist dabei abgeschaltet.
+
+// Für ppoll, inotify, mkdtemp, nftw und realpath
+#define _GNU_SOURCE
+
+#include "../config.h"
+#include "../display.h"
+#include "../latenz.h"
+#include "../logging.h"
+#include "../status_datei.h"
+#include <fcntl.h>
+#include <ftw.h>
+#include <limits.h>
+#include <math.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RATE_STANDARD 10            // Aktualisierungen pro Sekunde
+#define DAUER_STANDARD 10           // Sekunden je Modus
+#define NACHLAUF_MS 2000            // Nach der letzten Aktualisierung noch beobachten
+#define START_FRIST_MS 5000         // Bis die Firmware den Anfangswert anzeigt
+#define MAX_AKTUALISIERUNGEN 100000
+#define KODES 100                   // Eindeutige Werte (10.0 .. 19.9 °C)
+#define BASIS_ZEHNTEL 100           // 10.0 °C
+#define ALARM_TEXT "Temperatur zu hoch! "
+#define TEMP_DATEI_NEU TEMPERATURE_FILE ".neu"
+
+// Optionen, die jeder gestarteten Firmware mitgegeben werden (ohne
+// Start-Einblendungen, die die Sensor-Anzeige sonst einige Sekunden verdecken)
+#define FIRMWARE_OPTIONEN "--ausgabe datei --simulation aus --schnellstart"
+
+// Betriebsarten der Firmware, die die Latenz bestimmen
+typedef struct {
+    const char* name;
+    const char* optionen;
+} LastModus;
+
+static const LastModus modi[] = {
+    {"standard", ""},
+    {"bildrate_0", "--bildrate 0"},
+    {"intervall_100", "--sensor-intervall 100"},
+    {"intervall_100_bildrate_0", "--sensor-intervall 100 --bildrate 0"},
+    {"intervall_10_bildrate_0", "--sensor-intervall 10 --bildrate 0"},
+};
+
+#define MODUS_ANZAHL ((int)(sizeof(modi) / sizeof(modi[0])))
+
+// Eine Senke (Alarm-Log oder Display)
+typedef struct {
+    LatenzHistogramm latenz;
+    long naechste;                  // Kleinste noch nicht beobachtete Sequenznummer
+    long beobachtet;
+    long uebersprungen;             // Überschrieben, bevor die Firmware sie sah
+} Senke;
+
+// Ergebnis eines Modus
+typedef struct {
+    long geschrieben;
+    Senke erkennung;
+    Senke anzeige;
+} LastErgebnis;
+
+static uint64_t geschrieben_us[MAX_AKTUALISIERUNGEN];
+
+/**
+ * Schreibt eine Temperatur samt Sequenznummer atomar
+ */
+static int temperatur_schreiben(double temperatur, long sequenz) {
+    FILE* datei = fopen(TEMP_DATEI_NEU, "w");
+    if (datei == NULL) {
+        return 0;
+    }
+    fprintf(datei, "%.2f %ld\n", temperatur, sequenz);
+    if (fclose(datei) != 0) {
+        return 0;
+    }
+    return rename(TEMP_DATEI_NEU, TEMPERATURE_FILE) == 0;
+}
+
+/**
+ * Ordnet einen beobachteten Kode der jüngsten passenden Aktualisierung zu
+ * Wiederholt gemeldete Werte (gleicher Kode, schon zugeordnet) zählen nicht.
+ */
+static void beobachtung_zuordnen(Senke* senke, long geschrieben, long kode, uint64_t jetzt_us) {
+    if (geschrieben == 0 || kode < 0 || kode >= KODES) {
+        return;
+    }
+    long letzte = geschrieben - 1;
+    long sequenz = letzte - ((letzte % KODES) - kode + KODES) % KODES;
+    if (sequenz < senke->naechste) {
+        return;
+    }
+    latenz_erfassen(&senke->latenz, jetzt_us - geschrieben_us[sequenz]);
+    senke->uebersprungen += sequenz - senke->naechste;
+    senke->naechste = sequenz + 1;
+    senke->beobachtet++;
+}
+
+/**
+ * Liest neue Zeilen des Logs und sucht Temperatur-Alarme
+ */
+static void log_auswerten(int fd, char* rest, size_t* rest_laenge, size_t groesse,
+                          LastErgebnis* ergebnis, uint64_t jetzt_us) {
+    for (;;) {
+        ssize_t gelesen = read(fd, rest + *rest_laenge, groesse - 1 - *rest_laenge);
+        if (gelesen <= 0) {
+            return;
+        }
+        *rest_laenge += (size_t)gelesen;
+        rest[*rest_laenge] = '\0';
+
+        char* zeile = rest;
+        char* ende;
+        while ((ende = strchr(zeile, '\n')) != NULL) {
+            *ende = '\0';
+            char* alarm = strstr(zeile, ALARM_TEXT);
+            if (alarm != NULL) {
+                double temperatur = strtod(alarm + strlen(ALARM_TEXT), NULL);
+                long zehntel = lround(temperatur * 10.0);
+                beobachtung_zuordnen(&ergebnis->erkennung, ergebnis->geschrieben,
+                                     zehntel - BASIS_ZEHNTEL, jetzt_us);
+            }
+            zeile = ende + 1;
+        }
+
+        // Unvollständige Zeile für den nächsten Lesevorgang aufheben
+        *rest_laenge = strlen(zeile);
+        memmove(rest, zeile, *rest_laenge + 1);
+        if (*rest_laenge == groesse - 1) {
+            *rest_laenge = 0;
+        }
+    }
+}
+
+/**
+ * Liest den Status-Datensatz und ordnet die angezeigte Temperatur zu
+ */
+static void anzeige_auswerten(unsigned int* letzte_sequenz, LastErgebnis* ergebnis, uint64_t jetzt_us) {
+    StatusDaten status;
+    if (!status_datei_lesen(DISPLAY_DATEI, &status) || status.sequenz == *letzte_sequenz) {
+        return;
+    }
+    *letzte_sequenz = status.sequenz;
+    if (status.daten_gueltig) {
+        beobachtung_zuordnen(&ergebnis->anzeige, ergebnis->geschrieben,
+                             status.temperatur_zehntel - BASIS_ZEHNTEL, jetzt_us);
+    }
+}
+
+/**
+ * Wartet, bis die Firmware einen gültigen Messwert anzeigt
+ */
+static int firmware_bereit(void) {
+    for (int i = 0; i < START_FRIST_MS / 10; i++) {
+        StatusDaten status;
+        if (status_datei_lesen(DISPLAY_DATEI, &status) && status.daten_gueltig) {
+            return 1;
+        }
+        usleep(10000);
+    }
+    return 0;
+}
+
+/**
+ * Schreibt mit fester Rate und beobachtet Log und Display
+ * @return 1 bei Erfolg
+ */
+static int last_erzeugen(int rate, int dauer_s, LastErgebnis* ergebnis) {
+    memset(ergebnis, 0, sizeof(*ergebnis));
+
+    int inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    int log_fd = open(LOG_DATEI, O_RDONLY | O_CLOEXEC);
+    if (inotify < 0 || log_fd < 0 ||
+        inotify_add_watch(inotify, LOG_DATEI, IN_MODIFY) < 0 ||
+        inotify_add_watch(inotify, DISPLAY_DATEI, IN_MODIFY) < 0) {
+        perror("inotify");
+        if (inotify >= 0) close(inotify);
+        if (log_fd >= 0) close(log_fd);
+        return 0;
+    }
+    lseek(log_fd, 0, SEEK_END);
+
+    static char log_rest[8192];
+    size_t log_rest_laenge = 0;
+    unsigned int letzte_sequenz = 0;
+
+    long gesamt = (long)rate * dauer_s;
+    if (gesamt > MAX_AKTUALISIERUNGEN) {
+        gesamt = MAX_AKTUALISIERUNGEN;
+    }
+    uint64_t periode_us = 1000000ULL / (uint64_t)rate;
+    uint64_t start_us = latenz_jetzt_us();
+    uint64_t naechste_us = start_us;
+    uint64_t ende_us = start_us + (uint64_t)gesamt * periode_us + NACHLAUF_MS * 1000ULL;
+
+    for (;;) {
+        uint64_t jetzt_us = latenz_jetzt_us();
+        if (jetzt_us >= ende_us) {
+            break;
+        }
+        if (ergebnis->geschrieben < gesamt && jetzt_us >= naechste_us) {
+            long sequenz = ergebnis->geschrieben;
+            double temperatur = (BASIS_ZEHNTEL + sequenz % KODES) / 10.0;
+            geschrieben_us[sequenz] = latenz_jetzt_us();
+            if (!temperatur_schreiben(temperatur, sequenz)) {
+                perror(TEMPERATURE_FILE);
+                break;
+            }
+            ergebnis->geschrieben++;
+            naechste_us += periode_us;
+            continue;
+        }
+
+        uint64_t frist_us = ergebnis->geschrieben < gesamt ? naechste_us : ende_us;
+        uint64_t warten_us = frist_us > jetzt_us ? frist_us - jetzt_us : 0;
+        struct timespec warten = {(time_t)(warten_us / 1000000), (long)(warten_us % 1000000) * 1000};
+        struct pollfd pfd = {inotify, POLLIN, 0};
+        if (ppoll(&pfd, 1, &warten, NULL) > 0) {
+            char ereignisse[4096];
+            while (read(inotify, ereignisse, sizeof(ereignisse)) > 0) {
+            }
+            jetzt_us = latenz_jetzt_us();
+            log_auswerten(log_fd, log_rest, &log_rest_laenge, sizeof(log_rest), ergebnis, jetzt_us);
+            anzeige_auswerten(&letzte_sequenz, ergebnis, jetzt_us);
+        }
+    }
+
+    // Nie gesehene Aktualisierungen am Ende zählen als übersprungen
+    ergebnis->erkennung.uebersprungen += ergebnis->geschrieben - ergebnis->erkennung.naechste;
+    ergebnis->anzeige.uebersprungen += ergebnis->geschrieben - ergebnis->anzeige.naechste;
+
+    temperatur_schreiben(TARGET_TEMPERATURE, ergebnis->geschrieben);
+    close(log_fd);
+    close(inotify);
+    return 1;
+}
+
+/**
+ * Startet die Firmware im aktuellen Verzeichnis
+ * @return Prozess-ID, -1 bei Fehler
+ */
+static pid_t firmware_starten(const char* programm, const char* optionen) {
+    char befehl[512];
+    snprintf(befehl, sizeof(befehl), "%s %s", FIRMWARE_OPTIONEN, optionen);
+
+    char* argumente[32];
+    int anzahl = 0;
+    argumente[anzahl++] = (char*)programm;
+    for (char* wort = strtok(befehl, " "); wort != NULL && anzahl < 31; wort = strtok(NULL, " ")) {
+        argumente[anzahl++] = wort;
+    }
+    argumente[anzahl] = NULL;
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        int null = open("/dev/null", O_WRONLY);
+        if (null >= 0) {
+            dup2(null, STDOUT_FILENO);
+            dup2(null, STDERR_FILENO);
+        }
+        execv(programm, argumente);
+        _exit(127);
+    }
+    return pid;
+}
+
+static void firmware_beenden(pid_t pid) {
+    int status;
+    kill(pid, SIGINT);
+    waitpid(pid, &status, 0);
+}
+
+static int eintrag_loeschen(const char* pfad, const struct stat* info, int typ, struct FTW* ftw) {
+    (void)info;
+    (void)typ;
+    (void)ftw;
+    return remove(pfad);
+}
+
+/**
+ * Führt einen Modus mit frisch gestarteter Firmware in einem eigenen Verzeichnis aus
+ */
+static int modus_messen(const char* programm, const LastModus* modus, int rate, int dauer_s,
+                        LastErgebnis* ergebnis) {
+    char ursprung[PATH_MAX];
+    char verzeichnis[] = "/tmp/kuehlschrank_latenz_XXXXXX";
+    if (getcwd(ursprung, sizeof(ursprung)) == NULL || mkdtemp(verzeichnis) == NULL ||
+        chdir(verzeichnis) != 0 || mkdir("Workspace", 0755) != 0) {
+        perror("Arbeitsverzeichnis");
+        return 0;
+    }
+
+    int erfolg = 0;
+    temperatur_schreiben(TARGET_TEMPERATURE, 0);
+    pid_t pid = firmware_starten(programm, modus->optionen);
+    if (pid > 0) {
+        if (firmware_bereit()) {
+            erfolg = last_erzeugen(rate, dauer_s, ergebnis);
+        } else {
+            fprintf(stderr, "%s: Firmware zeigt keinen Messwert an\n", modus->name);
+        }
+        firmware_beenden(pid);
+    }
+
+    if (chdir(ursprung) != 0) {
+        perror(ursprung);
+    }
+    nftw(verzeichnis, eintrag_loeschen, 8, FTW_DEPTH | FTW_PHYS);
+    return erfolg;
+}
+
+static void senke_ausgeben(const char* name, const Senke* senke) {
+    printf("  %-10s %6ld gesehen %6ld übersprungen  p50 %7.1f ms  p90 %7.1f ms  p99 %7.1f ms  max %7.1f ms\n",
+           name, senke->beobachtet, senke->uebersprungen,
+           latenz_perzentil(&senke->latenz, 0.50) / 1000.0, latenz_perzentil(&senke->latenz, 0.90) / 1000.0,
+           latenz_perzentil(&senke->latenz, 0.99) / 1000.0, senke->latenz.max_us / 1000.0);
+}
+
+static void senke_json(FILE* datei, const char* name, const Senke* senke) {
+    fprintf(datei, "\"%s\": {\"gesehen\": %ld, \"uebersprungen\": %ld, \"p50_us\": %llu, "
+            "\"p90_us\": %llu, \"p99_us\": %llu, \"max_us\": %llu}",
+            name, senke->beobachtet, senke->uebersprungen,
+            (unsigned long long)latenz_perzentil(&senke->latenz, 0.50),
+            (unsigned long long)latenz_perzentil(&senke->latenz, 0.90),
+            (unsigned long long)latenz_perzentil(&senke->latenz, 0.99),
+            (unsigned long long)senke->latenz.max_us);
+}
+
+static void hilfe_anzeigen(const char* programm) {
+    printf("Verwendung: %s [Optionen]\n", programm);
+    printf("  --programm PFAD   Firmware, die je Modus gestartet wird (Standard: ./smart_fridge)\n");
+    printf("  --modus NAME      Nur diesen Modus messen\n");
+    printf("  --extern          Laufende Firmware im aktuellen Verzeichnis messen\n");
+    printf("                    (mit --simulation aus gestartet)\n");
+    printf("  --rate HZ         Aktualisierungen pro Sekunde (Standard: %d)\n", RATE_STANDARD);
+    printf("  --dauer S         Sekunden je Modus (Standard: %d)\n", DAUER_STANDARD);
+    printf("  --json DATEI      Ergebnisse als JSON schreiben\n");
+    printf("Modi:\n");
+    for (int i = 0; i < MODUS_ANZAHL; i++) {
+        printf("  %-26s %s\n", modi[i].name, modi[i].optionen[0] ? modi[i].optionen : "(Standard)");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const char* programm = "./smart_fridge";
+    const char* nur_modus = NULL;
+    const char* json_pfad = NULL;
+    int extern_messen = 0;
+    int rate = RATE_STANDARD;
+    int dauer_s = DAUER_STANDARD;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--programm") == 0 && i + 1 < argc) {
+            programm = argv[++i];
+        } else if (strcmp(argv[i], "--modus") == 0 && i + 1 < argc) {
+            nur_modus = argv[++i];
+        } else if (strcmp(argv[i], "--extern") == 0) {
+            extern_messen = 1;
+        } else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            rate = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--dauer") == 0 && i + 1 < argc) {
+            dauer_s = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_pfad = argv[++i];
+        } else {
+            hilfe_anzeigen(argv[0]);
+            return strcmp(argv[i], "--hilfe") == 0 ? 0 : 1;
+        }
+    }
+    if (rate < 1 || rate > 1000 || dauer_s < 1) {
+        fprintf(stderr, "Ungültige Rate (1-1000) oder Dauer\n");
+        return 1;
+    }
+
+    // Die Firmware wird aus einem anderen Verzeichnis gestartet
+    char programm_pfad[PATH_MAX];
+    if (!extern_messen && realpath(programm, programm_pfad) == NULL) {
+        perror(programm);
+        return 1;
+    }
+
+    FILE* json = NULL;
+    if (json_pfad != NULL) {
+        json = fopen(json_pfad, "w");
+        if (json == NULL) {
+            perror(json_pfad);
+            return 1;
+        }
+        fprintf(json, "{\n  \"rate\": %d,\n  \"dauer_s\": %d,\n  \"modi\": [", rate, dauer_s);
+    }
+
+    printf("%d Aktualisierungen/s für %d s je Modus\n", rate, dauer_s);
+    int gemessen = 0;
+    for (int i = 0; i < MODUS_ANZAHL; i++) {
+        const LastModus* modus = &modi[i];
+        static const LastModus extern_modus = {"extern", ""};
+        if (extern_messen) {
+            modus = &extern_modus;
+        } else if (nur_modus != NULL && strcmp(modus->name, nur_modus) != 0) {
+            continue;
+        }
+
+        static LastErgebnis ergebnis;
+        int erfolg = extern_messen ? last_erzeugen(rate, dauer_s, &ergebnis)
+                                   : modus_messen(programm_pfad, modus, rate, dauer_s, &ergebnis);
+        if (!erfolg) {
+            continue;
+        }
+
+        printf("%s %s: %ld geschrieben\n", modus->name, modus->optionen, ergebnis.geschrieben);
+        senke_ausgeben("Erkennung", &ergebnis.erkennung);
+        senke_ausgeben("Anzeige", &ergebnis.anzeige);
+        fflush(stdout);
+
+        if (json != NULL) {
+            fprintf(json, "%s\n    {\"name\": \"%s\", \"optionen\": \"%s\", \"geschrieben\": %ld, ",
+                    gemessen > 0 ? "," : "", modus->name, modus->optionen, ergebnis.geschrieben);
+            senke_json(json, "erkennung", &ergebnis.erkennung);
+            fprintf(json, ", ");
+            senke_json(json, "anzeige", &ergebnis.anzeige);
+            fprintf(json, "}");
+        }
+        gemessen++;
+        if (extern_messen) {
+            break;
+        }
+    }
+
+    if (json != NULL) {
+        fprintf(json, "\n  ]\n}\n");
+        fclose(json);
+    }
+    if (gemessen == 0) {
+        fprintf(stderr, "Kein Modus gemessen\n");
+        return 1;
+    }
+    return 0;
+}
@@ -10,6 +10,10 @@
 #define ENERGY_FILE "Workspace/energie.txt"
 #define BUTTON_FILE "Workspace/taster.txt"
 
+// Steuer-Socket für Laufzeit-Kommandos (smart_fridge --befehl ...)
+#define STEUER_SOCKET "Workspace/steuerung.sock"
+#define METRIKEN_DATEI "Workspace/metriken.prom"   // Prometheus-Textformat
+
 // Schwellenwerte für Alarme und Warnungen
 #define MAX_TEMP_THRESHOLD 8.0f     // Maximale Innentemperatur in °C
 #define MIN_TEMP_THRESHOLD -2.0f    // Minimale Innentemperatur in °C
@@ -27,6 +31,11 @@
 // Timing-Konfiguration
 #define SENSOR_UPDATE_INTERVAL 1    // Sensor-Überprüfung alle 1 Sekunde
 #define SENSOR_WRITE_INTERVAL 5     // Sensor-Werte schreiben alle 5 Sekunden
+#define TASTER_INTERVAL 2           // Taster-Datei prüfen alle 2 Sekunden
+#define STATUS_INTERVAL 30          // System-Status prüfen alle 30 Sekunden
+#define LATENZ_BERICHT_INTERVAL 60  // Latenz-Zusammenfassung ins Log alle 60 Sekunden
+#define METRIKEN_INTERVAL 15        // Metrik-Datei alle 15 Sekunden neu schreiben
+#define ABSCHALT_FRIST_MS 3000      // Harte Frist für das Herunterfahren nach SIGINT/SIGTERM
 
 // Logging-Level Definitionen
 typedef enum {
@@ -36,6 +45,16 @@ typedef enum {
     LOG_ERROR = 3
 } LogLevel;
 
+// Log-Kategorien (ein Level pro Kategorie, siehe logging.h)
+typedef enum {
+    LOG_KAT_SENSOR = 0,
+    LOG_KAT_DISPLAY = 1,
+    LOG_KAT_ALARM = 2,
+    LOG_KAT_SYSTEM = 3,
+    LOG_KAT_LOGGING = 4,
+    LOG_KAT_ANZAHL = 5
+} LogKategorie;
+
 // Sensor-Datenstruktur
 typedef struct {
     float temperatur;               // Aktuelle Temperatur in °C
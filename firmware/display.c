@@ -1,5 +1,14 @@
+// Für clock_gettime unter C99
+#define _POSIX_C_SOURCE 200809L
+
+#define LOG_KATEGORIE LOG_KAT_DISPLAY
+
 #include "display.h"
 #include "logging.h"
+#include "konsole.h"
+#include "terminal.h"
+#include "status_datei.h"
+#include "metriken.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -8,23 +17,72 @@
 // Globaler Display-Puffer
 DisplayPuffer display_puffer = {0};
 
+// Schatten-Puffer: was das physische Display gerade zeigt
+static char schatten[DISPLAY_ROWS][DISPLAY_COLS];
+static int schatten_gueltig = 0;        // 0 = Inhalt unbekannt, alles übertragen
+static const DisplayTreiber* treiber = NULL;
+static DisplayStatistik statistik = {0};
+
+// Sensor-Anzeige: zuletzt formatierte Zeilen und deren Eingaben
+static char sensor_zeile1[DISPLAY_COLS + 1];
+static char sensor_zeile2[DISPLAY_COLS + 1];
+static DisplaySchluessel letzter_schluessel;
+static int schluessel_gueltig = 0;      // 0 = noch keine Sensor-Daten angezeigt
+
+// Zeitlich begrenzte Einblendungen über der Sensor-Anzeige
+typedef struct {
+    char zeile1[DISPLAY_COLS + 1];
+    char zeile2[DISPLAY_COLS + 1];
+    int eigene_zeile1;                  // 0 = Sensor-Zeile bleibt sichtbar
+    int eigene_zeile2;
+    DisplayPrioritaet prioritaet;
+    int dauer_ms;                       // 0 = bis display_overlays_leeren()
+    long long ablauf_ms;                // Gesetzt beim ersten Anzeigen (0 = wartet)
+    unsigned long nummer;               // Reihenfolge innerhalb einer Priorität
+} DisplayOverlay;
+
+static DisplayOverlay overlays[DISPLAY_OVERLAY_MAX];
+static int overlay_anzahl = 0;
+static unsigned long overlay_nummer = 0;
+
+// Änderungen markieren die Anzeige; ausgegeben wird höchstens einmal pro Bild
+static int anzeige_geaendert = 0;
+static long long letzte_ausgabe_ms = 0;
+static int bild_intervall_ms = 1000 / DISPLAY_BILDRATE_STANDARD;
+
+static long long monotone_ms(void);
+static DisplayOverlay* overlay_aktivieren(long long jetzt);
+static void anzeige_markieren(void);
+static void anzeige_ausgeben(long long jetzt);
+
 /**
  * Initialisiert das I2C Display System
  */
 void display_initialisieren(void) {
     LOG_INFO_MSG("Display-System wird initialisiert...");
     
+    metrik_zaehler_registrieren("display_bilder_total", NULL, "Ausgegebene Display-Bilder",
+                                &statistik.bilder);
+    metrik_zaehler_registrieren("display_zusammengefasst_total", NULL,
+                                "Änderungen, die in ein wartendes Bild fielen", &statistik.zusammengefasst);
+    metrik_zaehler_registrieren("display_zeichen_total", NULL, "An das Display übertragene Zeichen",
+                                &statistik.zeichen);
+    metrik_zaehler_registrieren("display_overlays_verworfen_total", NULL,
+                                "Einblendungen, die bei voller Warteschlange verworfen wurden",
+                                &statistik.overlays_verworfen);
+    
     // Display-Puffer zurücksetzen
     memset(&display_puffer, 0, sizeof(DisplayPuffer));
-    
-    // Startbildschirm anzeigen
-    display_startbildschirm_anzeigen();
-    
+    display_zeile_abschliessen(sensor_zeile1, 0);
+    display_zeile_abschliessen(sensor_zeile2, 0);
+    schluessel_gueltig = 0;
+    overlay_anzahl = 0;
+    anzeige_geaendert = 0;
+    letzte_ausgabe_ms = monotone_ms() - bild_intervall_ms;
     display_puffer.initialisiert = 1;
-    display_puffer.aktualisiert = 1;
     
-    // Initial auf Konsole ausgeben
-    display_ausgeben();
+    // Startbildschirm anzeigen (Einblendung, läuft ohne Warten ab)
+    display_startbildschirm_anzeigen();
     
     LOG_INFO_MSG("Display-System erfolgreich initialisiert");
 }
@@ -43,28 +101,21 @@ void display_aktualisieren(const SensorDaten* daten, int log_level) {
         return;
     }
     
-    // Neue Zeilen formatieren
-    char neue_zeile1[DISPLAY_COLS + 1];
-    char neue_zeile2[DISPLAY_COLS + 1];
+    // Gleiche Eingaben ergeben gleiche Zeilen: Formatieren überspringen
+    DisplaySchluessel schluessel;
+    display_schluessel_berechnen(daten, log_level, &schluessel);
+    if (schluessel_gueltig && display_schluessel_gleich(&schluessel, &letzter_schluessel)) {
+        statistik.formatierungen_gespart++;
+        return;
+    }
     
-    display_zeile1_formatieren(neue_zeile1, daten, log_level);
-    display_zeile2_formatieren(neue_zeile2, daten);
+    display_zeile1_formatieren(sensor_zeile1, daten, log_level);
+    display_zeile2_formatieren(sensor_zeile2, daten);
+    letzter_schluessel = schluessel;
+    schluessel_gueltig = 1;
+    statistik.formatierungen++;
     
-    // Prüfen ob sich etwas geändert hat
-    if (strcmp(display_puffer.zeile1, neue_zeile1) != 0 || 
-        strcmp(display_puffer.zeile2, neue_zeile2) != 0) {
-        
-        // Puffer aktualisieren
-        strcpy(display_puffer.zeile1, neue_zeile1);
-        strcpy(display_puffer.zeile2, neue_zeile2);
-        display_puffer.aktualisiert = 1;
-        
-        // Display ausgeben
-        display_ausgeben();
-        display_in_datei_schreiben(DISPLAY_DATEI);
-        
-        LOG_DEBUG_MSG("Display aktualisiert");
-    }
+    anzeige_markieren();
 }
 
 /**
@@ -73,14 +124,10 @@ void display_aktualisieren(const SensorDaten* daten, int log_level) {
 void display_warnung_anzeigen(const char* warnung_text) {
     if (warnung_text == NULL) return;
     
-    // Einfache Warnung
-    strncpy(display_puffer.zeile2, "WARNUNG: ", DISPLAY_COLS);
-    strncat(display_puffer.zeile2, warnung_text, DISPLAY_COLS - 9);
-    zeile_auffuellen(display_puffer.zeile2);
-    
-    display_puffer.aktualisiert = 1;
-    display_ausgeben();
-    display_in_datei_schreiben(DISPLAY_DATEI);
+    char zeile[DISPLAY_COLS + 1];
+    int pos = display_text_anhaengen(zeile, 0, "WARNUNG: ");
+    display_zeile_abschliessen(zeile, display_text_anhaengen(zeile, pos, warnung_text));
+    display_overlay_zeigen(NULL, zeile, DISPLAY_WARNUNG_DAUER_MS, DISPLAY_PRIO_WARNUNG);
     
     LOG_DEBUG_F("Warnung auf Display angezeigt: %s", warnung_text);
 }
@@ -91,17 +138,10 @@ void display_warnung_anzeigen(const char* warnung_text) {
 void display_fehler_anzeigen(const char* fehler_text) {
     if (fehler_text == NULL) return;
     
-    // Einfache Fehlermeldung
-    strncpy(display_puffer.zeile1, "FEHLER: ", DISPLAY_COLS);
-    strncat(display_puffer.zeile1, fehler_text, DISPLAY_COLS - 8);
-    strncpy(display_puffer.zeile2, "System pruefen!", DISPLAY_COLS);
-    
-    zeile_auffuellen(display_puffer.zeile1);
-    zeile_auffuellen(display_puffer.zeile2);
-    
-    display_puffer.aktualisiert = 1;
-    display_ausgeben();
-    display_in_datei_schreiben(DISPLAY_DATEI);
+    char zeile[DISPLAY_COLS + 1];
+    int pos = display_text_anhaengen(zeile, 0, "FEHLER: ");
+    display_zeile_abschliessen(zeile, display_text_anhaengen(zeile, pos, fehler_text));
+    display_overlay_zeigen(zeile, "System pruefen!", DISPLAY_FEHLER_DAUER_MS, DISPLAY_PRIO_FEHLER);
     
     LOG_ERROR_F("Fehler auf Display angezeigt: %s", fehler_text);
 }
@@ -110,102 +150,513 @@ void display_fehler_anzeigen(const char* fehler_text) {
  * Löscht das Display
  */
 void display_loeschen(void) {
-    strcpy(display_puffer.zeile1, LEER_ZEILE);
-    strcpy(display_puffer.zeile2, LEER_ZEILE);
-    display_puffer.aktualisiert = 1;
+    display_zeile_abschliessen(sensor_zeile1, 0);
+    display_zeile_abschliessen(sensor_zeile2, 0);
+    schluessel_gueltig = 0;
     
-    display_ausgeben();
+    anzeige_markieren();
     LOG_DEBUG_MSG("Display gelöscht");
 }
 
 /**
- * Formatiert die erste Zeile mit Sensor-Daten
+ * Reiht eine zeitlich begrenzte Einblendung ein
  */
-void display_zeile1_formatieren(char* zeile, const SensorDaten* daten, int log_level) {
-    char log_char = log_level_zu_zeichen(log_level);
+int display_overlay_zeigen(const char* zeile1, const char* zeile2, int dauer_ms,
+                           DisplayPrioritaet prioritaet) {
+    char text1[DISPLAY_COLS + 1];
+    char text2[DISPLAY_COLS + 1];
+    display_zeile_abschliessen(text1, zeile1 ? display_text_anhaengen(text1, 0, zeile1) : 0);
+    display_zeile_abschliessen(text2, zeile2 ? display_text_anhaengen(text2, 0, zeile2) : 0);
+    
+    // Gleiche Einblendung bereits vorhanden: nur verlängern (z.B. wiederholte Lesefehler)
+    for (int i = 0; i < overlay_anzahl; i++) {
+        DisplayOverlay* o = &overlays[i];
+        if (o->prioritaet == prioritaet &&
+            o->eigene_zeile1 == (zeile1 != NULL) && o->eigene_zeile2 == (zeile2 != NULL) &&
+            memcmp(o->zeile1, text1, DISPLAY_COLS) == 0 && memcmp(o->zeile2, text2, DISPLAY_COLS) == 0) {
+            o->dauer_ms = dauer_ms;
+            if (o->ablauf_ms != 0) {
+                o->ablauf_ms = dauer_ms > 0 ? monotone_ms() + dauer_ms : 0;
+            }
+            return 1;
+        }
+    }
     
-    // Einfaches Format ohne komplexe snprintf
-    char temp_str[10], energie_str[10];
-    sprintf(temp_str, "%.1f", daten->temperatur);
-    sprintf(energie_str, "%.0f", daten->energie_verbrauch);
+    // Warteschlange voll: älteste Einblendung niedrigster Priorität verdrängen
+    if (overlay_anzahl == DISPLAY_OVERLAY_MAX) {
+        int opfer = 0;
+        for (int i = 1; i < overlay_anzahl; i++) {
+            if (overlays[i].prioritaet < overlays[opfer].prioritaet ||
+                (overlays[i].prioritaet == overlays[opfer].prioritaet &&
+                 overlays[i].nummer < overlays[opfer].nummer)) {
+                opfer = i;
+            }
+        }
+        if (overlays[opfer].prioritaet > prioritaet) {
+            statistik.overlays_verworfen++;
+            return 0;
+        }
+        overlays[opfer] = overlays[--overlay_anzahl];
+        statistik.overlays_verworfen++;
+    }
     
-    strcpy(zeile, "");
-    strncat(zeile, &log_char, 1);
-    strcat(zeile, " T:");
-    strcat(zeile, temp_str);
-    strcat(zeile, "C D:");
-    strcat(zeile, daten->tuer_offen ? "OFFEN" : "ZU");
-    strcat(zeile, " E:");
-    strcat(zeile, energie_str);
-    strcat(zeile, "W");
+    DisplayOverlay* neu = &overlays[overlay_anzahl++];
+    memcpy(neu->zeile1, text1, sizeof(text1));
+    memcpy(neu->zeile2, text2, sizeof(text2));
+    neu->eigene_zeile1 = (zeile1 != NULL);
+    neu->eigene_zeile2 = (zeile2 != NULL);
+    neu->prioritaet = prioritaet;
+    neu->dauer_ms = dauer_ms;
+    neu->ablauf_ms = 0;
+    neu->nummer = ++overlay_nummer;
+    
+    anzeige_markieren();
+    return 1;
+}
+
+/**
+ * Entfernt abgelaufene Einblendungen und gibt Änderungen aus
+ */
+void display_zyklus(void) {
+    long long jetzt = monotone_ms();
+    for (int i = 0; i < overlay_anzahl; ) {
+        if (overlays[i].ablauf_ms != 0 && jetzt >= overlays[i].ablauf_ms) {
+            overlays[i] = overlays[--overlay_anzahl];
+            anzeige_markieren();
+        } else {
+            i++;
+        }
+    }
     
-    zeile_auffuellen(zeile);
+    // Alle Änderungen seit dem letzten Bild ergeben eine Ausgabe
+    if (anzeige_geaendert && jetzt - letzte_ausgabe_ms >= bild_intervall_ms) {
+        anzeige_ausgeben(jetzt);
+    }
+}
+
+/**
+ * Zeit bis display_zyklus() wieder etwas zu tun hat
+ */
+int display_wartezeit_ms(int maximum) {
+    long long jetzt = monotone_ms();
+    long long warten = maximum;
+    
+    if (anzeige_geaendert) {
+        long long bild = letzte_ausgabe_ms + bild_intervall_ms - jetzt;
+        if (bild < warten) {
+            warten = bild;
+        }
+    }
+    for (int i = 0; i < overlay_anzahl; i++) {
+        if (overlays[i].ablauf_ms != 0 && overlays[i].ablauf_ms - jetzt < warten) {
+            warten = overlays[i].ablauf_ms - jetzt;
+        }
+    }
+    
+    return warten > 0 ? (int)warten : 0;
+}
+
+/**
+ * Setzt die maximale Bildrate
+ */
+int display_bildrate_setzen(int bilder_pro_sekunde) {
+    if (bilder_pro_sekunde < 0 || bilder_pro_sekunde > 1000) {
+        return 0;
+    }
+    bild_intervall_ms = bilder_pro_sekunde > 0 ? 1000 / bilder_pro_sekunde : 0;
+    return 1;
+}
+
+/**
+ * Liefert die eingestellte Bildrate
+ */
+int display_bildrate_abfragen(void) {
+    return bild_intervall_ms > 0 ? 1000 / bild_intervall_ms : 0;
+}
+
+/**
+ * Verwirft alle Einblendungen
+ */
+void display_overlays_leeren(void) {
+    overlay_anzahl = 0;
+    anzeige_markieren();
+}
+
+/**
+ * Anzahl wartender bzw. angezeigter Einblendungen
+ */
+int display_overlay_anzahl(void) {
+    return overlay_anzahl;
+}
+
+/**
+ * Wählt die anzuzeigende Einblendung und startet deren Ablaufzeit
+ */
+static DisplayOverlay* overlay_aktivieren(long long jetzt) {
+    DisplayOverlay* beste = NULL;
+    for (int i = 0; i < overlay_anzahl; i++) {
+        DisplayOverlay* o = &overlays[i];
+        if (beste == NULL || o->prioritaet > beste->prioritaet ||
+            (o->prioritaet == beste->prioritaet && o->nummer < beste->nummer)) {
+            beste = o;
+        }
+    }
+    
+    if (beste != NULL && beste->ablauf_ms == 0 && beste->dauer_ms > 0) {
+        beste->ablauf_ms = jetzt + beste->dauer_ms;
+    }
+    return beste;
+}
+
+/**
+ * Merkt eine Änderung für die nächste Ausgabe vor
+ */
+static void anzeige_markieren(void) {
+    if (anzeige_geaendert) {
+        statistik.zusammengefasst++;
+    }
+    anzeige_geaendert = 1;
+}
+
+/**
+ * Setzt Sensor-Anzeige und Einblendung zusammen und gibt Änderungen aus
+ */
+static void anzeige_ausgeben(long long jetzt) {
+    const DisplayOverlay* o = overlay_aktivieren(jetzt);
+    
+    anzeige_geaendert = 0;
+    letzte_ausgabe_ms = jetzt;
+    statistik.bilder++;
+    
+    memcpy(display_puffer.zeile1, (o && o->eigene_zeile1) ? o->zeile1 : sensor_zeile1, DISPLAY_COLS + 1);
+    memcpy(display_puffer.zeile2, (o && o->eigene_zeile2) ? o->zeile2 : sensor_zeile2, DISPLAY_COLS + 1);
+    
+    // Nur geänderte Zeichen übertragen; ohne Änderung auch keine Konsole/Datei
+    int laeufe = display_panel_abgleichen();
+    if (laeufe > 0) {
+        display_puffer.aktualisiert = 1;
+        display_ausgeben();
+        display_in_datei_schreiben(DISPLAY_DATEI);
+        
+        LOG_DEBUG_F("Display aktualisiert (%d Bereiche)", laeufe);
+    }
+}
+
+/**
+ * Monotone Zeit in Millisekunden
+ */
+static long long monotone_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/**
+ * Ermittelt die angezeigten Eingaben in Anzeige-Auflösung
+ */
+void display_schluessel_berechnen(const SensorDaten* daten, int log_level, DisplaySchluessel* schluessel) {
+    unsigned int alarme = 0;
+    
+    // Dieselben Bedingungen wie in display_zeile2_formatieren()
+    if (daten->temperatur > MAX_TEMP_THRESHOLD) {
+        alarme |= DISPLAY_ALARM_TEMP_HOCH;
+    }
+    if (daten->temperatur < MIN_TEMP_THRESHOLD) {
+        alarme |= DISPLAY_ALARM_TEMP_NIEDRIG;
+    }
+    if (daten->tuer_offen && time(NULL) - daten->tuer_offen_seit > DOOR_OPEN_THRESHOLD) {
+        alarme |= DISPLAY_ALARM_TUER;
+    }
+    if (daten->energie_verbrauch > MAX_ENERGY_THRESHOLD) {
+        alarme |= DISPLAY_ALARM_ENERGIE;
+    }
+    if (!daten->gueltig) {
+        alarme |= DISPLAY_ALARM_UNGUELTIG;
+    }
+    
+    schluessel->temperatur = display_festkomma(daten->temperatur, 1);
+    schluessel->energie = display_festkomma(daten->energie_verbrauch, 0);
+    schluessel->tuer_offen = daten->tuer_offen ? 1 : 0;
+    schluessel->log_level = (unsigned char)log_level;
+    schluessel->alarme = (unsigned char)alarme;
+}
+
+/**
+ * Vergleicht zwei Schlüssel
+ */
+int display_schluessel_gleich(const DisplaySchluessel* a, const DisplaySchluessel* b) {
+    return a->temperatur == b->temperatur &&
+           a->energie == b->energie &&
+           a->tuer_offen == b->tuer_offen &&
+           a->log_level == b->log_level &&
+           a->alarme == b->alarme;
+}
+
+/**
+ * Formatiert die erste Zeile mit Sensor-Daten
+ * Schreibt in einem Durchlauf direkt in den Zeilenpuffer (ohne sprintf/strcat)
+ */
+void display_zeile1_formatieren(char* zeile, const SensorDaten* daten, int log_level) {
+    int pos = 0;
+    
+    zeile[pos++] = log_level_zu_zeichen(log_level);
+    pos = display_text_anhaengen(zeile, pos, " T:");
+    pos = display_festkomma_anhaengen(zeile, pos, display_festkomma(daten->temperatur, 1), 1);
+    pos = display_text_anhaengen(zeile, pos, "C D:");
+    pos = display_text_anhaengen(zeile, pos, daten->tuer_offen ? "OFFEN" : "ZU");
+    pos = display_text_anhaengen(zeile, pos, " E:");
+    pos = display_festkomma_anhaengen(zeile, pos, display_festkomma(daten->energie_verbrauch, 0), 0);
+    pos = display_text_anhaengen(zeile, pos, "W");
+    
+    display_zeile_abschliessen(zeile, pos);
 }
 
 /**
  * Formatiert die zweite Zeile mit Status-Informationen
  */
 void display_zeile2_formatieren(char* zeile, const SensorDaten* daten) {
+    const char* status;
+    
     // Einfache Status-Meldungen
     if (!daten->gueltig) {
-        strcpy(zeile, "SENSOR-FEHLER!");
+        status = "SENSOR-FEHLER!";
     }
     else if (daten->temperatur > MAX_TEMP_THRESHOLD) {
-        strcpy(zeile, "TEMPERATUR ZU HOCH!");
+        status = "TEMPERATUR ZU HOCH!";
     }
     else if (daten->temperatur < MIN_TEMP_THRESHOLD) {
-        strcpy(zeile, "TEMPERATUR ZU NIEDRIG!");
+        status = "TEMPERATUR ZU NIEDRIG!";
     }
     else if (daten->tuer_offen) {
         long offen_dauer = time(NULL) - daten->tuer_offen_seit;
         if (offen_dauer > DOOR_OPEN_THRESHOLD) {
-            strcpy(zeile, "TUER ZU LANGE OFFEN!");
+            status = "TUER ZU LANGE OFFEN!";
         } else {
-            strcpy(zeile, "Tuer ist offen");
+            status = "Tuer ist offen";
         }
     }
     else if (daten->energie_verbrauch > MAX_ENERGY_THRESHOLD) {
-        strcpy(zeile, "ENERGIEVERBRAUCH ZU HOCH!");
+        status = "ENERGIEVERBRAUCH ZU HOCH!";
     }
     else {
-        strcpy(zeile, "Status: OK - Alle Werte normal");
+        status = "Status: OK - Alle Werte normal";
     }
     
-    zeile_auffuellen(zeile);
+    display_zeile_abschliessen(zeile, display_text_anhaengen(zeile, 0, status));
+}
+
+/**
+ * Hängt Text an, höchstens bis zum Zeilenende
+ */
+int display_text_anhaengen(char* zeile, int position, const char* text) {
+    while (position < DISPLAY_COLS && *text != '\0') {
+        zeile[position++] = *text++;
+    }
+    return position;
+}
+
+/**
+ * Hängt eine Festkomma-Zahl an, höchstens bis zum Zeilenende
+ */
+int display_festkomma_anhaengen(char* zeile, int position, long wert, int nachkommastellen) {
+    char ziffern[24];
+    int anzahl = 0;
+    unsigned long betrag = (wert < 0) ? 0UL - (unsigned long)wert : (unsigned long)wert;
+    
+    // Ziffern rückwärts erzeugen, mindestens eine Vorkommastelle
+    do {
+        ziffern[anzahl++] = (char)('0' + betrag % 10);
+        betrag /= 10;
+        if (anzahl == nachkommastellen) {
+            ziffern[anzahl++] = '.';
+            if (betrag == 0) {
+                ziffern[anzahl++] = '0';
+            }
+        }
+    } while (betrag != 0 || anzahl <= nachkommastellen);
+    
+    if (wert < 0 && position < DISPLAY_COLS) {
+        zeile[position++] = '-';
+    }
+    while (anzahl > 0 && position < DISPLAY_COLS) {
+        zeile[position++] = ziffern[--anzahl];
+    }
+    return position;
+}
+
+/**
+ * Rundet einen Messwert auf eine Festkomma-Zahl
+ */
+long display_festkomma(float wert, int nachkommastellen) {
+    // In double ist das Skalieren eines float-Werts mit 10 bzw. 100 exakt
+    double skaliert = wert;
+    for (int i = 0; i < nachkommastellen; i++) {
+        skaliert *= 10.0;
+    }
+    
+    // Unplausible Werte begrenzen statt beim Umwandeln überzulaufen
+    if (skaliert > 999999.0) {
+        skaliert = 999999.0;
+    } else if (skaliert < -999999.0) {
+        skaliert = -999999.0;
+    }
+    
+    // Wie printf: exakte Halbwerte zur geraden Zahl runden
+    double betrag = skaliert < 0.0 ? -skaliert : skaliert;
+    long ganz = (long)betrag;
+    double rest = betrag - (double)ganz;
+    if (rest > 0.5 || (rest == 0.5 && (ganz & 1))) {
+        ganz++;
+    }
+    return skaliert < 0.0 ? -ganz : ganz;
+}
+
+/**
+ * Füllt ab der Position mit Leerzeichen auf und terminiert die Zeile
+ */
+void display_zeile_abschliessen(char* zeile, int position) {
+    if (position < DISPLAY_COLS) {
+        memset(zeile + position, ' ', (size_t)(DISPLAY_COLS - position));
+    }
+    zeile[DISPLAY_COLS] = '\0';
 }
 
 /**
  * Gibt das Display auf der Konsole aus
  */
 void display_ausgeben(void) {
-    printf("\n");
-    printf("┌──────────────────────────────────────────┐\n");
-    printf("│%s│\n", display_puffer.zeile1);
-    printf("│%s│\n", display_puffer.zeile2);
-    printf("└──────────────────────────────────────────┘\n");
-    fflush(stdout);
+    const char* const zeilen[DISPLAY_ROWS] = { display_puffer.zeile1, display_puffer.zeile2 };
+    
+    // Auf einem Terminal nur geänderte Zeichen, sonst der vollständige Rahmen
+    terminal_aktualisieren(zeilen);
 }
 
 /**
- * Schreibt Display-Inhalt in eine Datei
+ * Überträgt geänderte Bereiche an das physische Display
  */
-void display_in_datei_schreiben(const char* dateiname) {
-    FILE* datei = fopen(dateiname, "w");
-    if (datei == NULL) {
-        LOG_WARNING_F("Konnte Display-Datei nicht schreiben: %s", dateiname);
-        return;
+int display_panel_abgleichen(void) {
+    const char* soll[DISPLAY_ROWS] = { display_puffer.zeile1, display_puffer.zeile2 };
+    DisplayLauf laeufe[DISPLAY_ROWS * DISPLAY_MAX_LAEUFE];
+    int anzahl = 0;
+    
+    for (int z = 0; z < DISPLAY_ROWS; z++) {
+        if (schatten_gueltig) {
+            anzahl += display_laeufe_berechnen(schatten[z], soll[z], z,
+                                               laeufe + anzahl, DISPLAY_MAX_LAEUFE);
+        } else {
+            laeufe[anzahl].zeile = z;
+            laeufe[anzahl].spalte = 0;
+            laeufe[anzahl].laenge = DISPLAY_COLS;
+            anzahl++;
+        }
     }
     
-    fprintf(datei, "Smart Kühlschrank Display (2x40 Zeichen)\n");
-    fprintf(datei, "========================================\n");
-    fprintf(datei, "Zeile 1: %s\n", display_puffer.zeile1);
-    fprintf(datei, "Zeile 2: %s\n", display_puffer.zeile2);
-    fprintf(datei, "========================================\n");
+    for (int i = 0; i < anzahl; i++) {
+        const DisplayLauf* lauf = &laeufe[i];
+        const char* daten = soll[lauf->zeile] + lauf->spalte;
+        
+        if (treiber != NULL) {
+            treiber->cursor_setzen(lauf->zeile, lauf->spalte);
+            treiber->daten_schreiben(daten, lauf->laenge);
+        }
+        memcpy(&schatten[lauf->zeile][lauf->spalte], daten, (size_t)lauf->laenge);
+        statistik.zeichen += (unsigned long)lauf->laenge;
+    }
     
-    time_t jetzt = time(NULL);
-    fprintf(datei, "Letzte Aktualisierung: %s", ctime(&jetzt));
+    if (anzahl > 0) {
+        statistik.abgleiche++;
+        statistik.laeufe += (unsigned long)anzahl;
+        statistik.zeichen_voll += DISPLAY_ROWS * DISPLAY_COLS;
+    }
+    schatten_gueltig = 1;
+    return anzahl;
+}
+
+/**
+ * Ermittelt die geänderten Bereiche einer Zeile
+ */
+int display_laeufe_berechnen(const char* alt, const char* neu, int zeile,
+                             DisplayLauf* laeufe, int max_laeufe) {
+    int anzahl = 0;
+    int spalte = 0;
+    
+    while (spalte < DISPLAY_COLS) {
+        // Nächste Abweichung suchen
+        while (spalte < DISPLAY_COLS && alt[spalte] == neu[spalte]) {
+            spalte++;
+        }
+        if (spalte == DISPLAY_COLS) {
+            break;
+        }
+        
+        // Bereich bis zur nächsten ausreichend großen Lücke ausdehnen
+        int anfang = spalte;
+        int ende = spalte + 1;      // Exklusiv, letzte Abweichung + 1
+        spalte++;
+        while (spalte < DISPLAY_COLS) {
+            if (alt[spalte] != neu[spalte]) {
+                ende = ++spalte;
+            } else if (spalte - ende >= DISPLAY_LAUF_MAX_LUECKE) {
+                break;
+            } else {
+                spalte++;
+            }
+        }
+        
+        if (anzahl == max_laeufe) {
+            // Kein Platz mehr: letzten Bereich bis hierher verlängern
+            laeufe[anzahl - 1].laenge = ende - laeufe[anzahl - 1].spalte;
+            continue;
+        }
+        laeufe[anzahl].zeile = zeile;
+        laeufe[anzahl].spalte = anfang;
+        laeufe[anzahl].laenge = ende - anfang;
+        anzahl++;
+    }
     
-    fclose(datei);
+    return anzahl;
+}
+
+/**
+ * Setzt den Treiber des physischen Displays
+ */
+void display_treiber_setzen(const DisplayTreiber* neuer_treiber) {
+    treiber = neuer_treiber;
+    schatten_gueltig = 0;
+    if (treiber != NULL) {
+        LOG_INFO_F("Display-Treiber: %s", treiber->name);
+    }
+}
+
+/**
+ * Liefert die Zähler des Display-Abgleichs
+ */
+void display_statistik_abfragen(DisplayStatistik* ziel) {
+    *ziel = statistik;
+}
+
+/**
+ * Schreibt den Status-Datensatz (Display-Inhalt und angezeigte Werte)
+ */
+void display_in_datei_schreiben(const char* dateiname) {
+    if (!(ausgabe_modus & AUSGABE_DATEI)) {
+        return;
+    }
+    
+    StatusDaten status;
+    status.zeit = (long)time(NULL);
+    memcpy(status.zeile1, display_puffer.zeile1, sizeof(status.zeile1));
+    memcpy(status.zeile2, display_puffer.zeile2, sizeof(status.zeile2));
+    status.daten_gueltig = schluessel_gueltig;
+    status.temperatur_zehntel = letzter_schluessel.temperatur;
+    status.tuer_offen = letzter_schluessel.tuer_offen;
+    status.energie_watt = letzter_schluessel.energie;
+    status.log_level = letzter_schluessel.log_level;
+    status.alarme = letzter_schluessel.alarme;
+    
+    if (!status_datei_schreiben(dateiname, &status)) {
+        LOG_WARNING_F("Konnte Display-Datei nicht schreiben: %s", dateiname);
+    }
 }
 
 /**
@@ -281,11 +732,11 @@ void fortschrittsbalken_erstellen(float wert, float minimum, float maximum,
  * Zeigt Startbildschirm an
  */
 void display_startbildschirm_anzeigen(void) {
-    text_zentrieren(display_puffer.zeile1, "Smart Kuehlschrank v1.0");
-    text_zentrieren(display_puffer.zeile2, "System wird gestartet...");
-    
-    display_ausgeben();
-    display_in_datei_schreiben(DISPLAY_DATEI);
+    char zeile1[DISPLAY_COLS + 1];
+    char zeile2[DISPLAY_COLS + 1];
+    text_zentrieren(zeile1, "Smart Kuehlschrank v1.0");
+    text_zentrieren(zeile2, "System wird gestartet...");
+    display_overlay_zeigen(zeile1, zeile2, DISPLAY_START_DAUER_MS, DISPLAY_PRIO_INFO);
     
     LOG_INFO_MSG("Startbildschirm angezeigt");
 }
@@ -294,22 +745,26 @@ void display_startbildschirm_anzeigen(void) {
  * Zeigt Systeminformationen an
  */
 void display_systeminfo_anzeigen(void) {
-    strcpy(display_puffer.zeile1, "Soll: 4.0C | Max: 8.0C | Min: -2.0C     ");
-    strcpy(display_puffer.zeile2, "Energie Soll: 120W | Max: 200W         ");
-    
-    display_ausgeben();
-    display_in_datei_schreiben(DISPLAY_DATEI);
+    display_overlay_zeigen("Soll: 4.0C | Max: 8.0C | Min: -2.0C",
+                           "Energie Soll: 120W | Max: 200W",
+                           DISPLAY_SYSTEMINFO_DAUER_MS, DISPLAY_PRIO_INFO);
 }
 
 /**
  * Beendet das Display-System
  */
 void display_beenden(void) {
-    text_zentrieren(display_puffer.zeile1, "System wird beendet...");
-    text_zentrieren(display_puffer.zeile2, "Auf Wiedersehen!");
-    
-    display_ausgeben();
-    display_in_datei_schreiben(DISPLAY_DATEI);
+    char zeile1[DISPLAY_COLS + 1];
+    char zeile2[DISPLAY_COLS + 1];
+    text_zentrieren(zeile1, "System wird beendet...");
+    text_zentrieren(zeile2, "Auf Wiedersehen!");
+    
+    // Abschiedsbild bleibt nach Programmende auf dem Display stehen
+    overlay_anzahl = 0;
+    display_overlay_zeigen(zeile1, zeile2, 0, DISPLAY_PRIO_FEHLER);
+    anzeige_ausgeben(monotone_ms());
+    status_datei_schliessen();
+    terminal_beenden();
     
     LOG_INFO_MSG("Display-System beendet");
 }
@@ -14,6 +14,57 @@ typedef struct {
     int initialisiert;              // Flag für Initialisierung
 } DisplayPuffer;
 
+// Zusammenhängender Bereich geänderter Zeichen einer Zeile
+typedef struct {
+    int zeile;                      // 0 oder 1
+    int spalte;                     // Erste geänderte Spalte
+    int laenge;                     // Anzahl zu übertragender Zeichen
+} DisplayLauf;
+
+// Physisches Display; erhält nur geänderte Bereiche (Cursor setzen + Daten)
+typedef struct {
+    const char* name;
+    void (*cursor_setzen)(int zeile, int spalte);
+    void (*daten_schreiben)(const char* daten, int laenge);
+} DisplayTreiber;
+
+// Zähler des Display-Abgleichs
+typedef struct {
+    unsigned long abgleiche;        // Abgleiche mit mindestens einer Änderung
+    unsigned long laeufe;           // Übertragene Bereiche (je eine Cursor-Positionierung)
+    unsigned long zeichen;          // Übertragene Zeichen
+    unsigned long zeichen_voll;     // Zeichen bei vollständigem Neuschreiben
+    unsigned long formatierungen;   // Neu formatierte Sensor-Anzeigen
+    unsigned long formatierungen_gespart; // Übersprungen, Eingaben unverändert
+    unsigned long overlays_verworfen; // Einblendungen bei voller Warteschlange
+    unsigned long bilder;           // Ausgaben (höchstens eine pro Bild-Intervall)
+    unsigned long zusammengefasst;  // Änderungen, die in eine wartende Ausgabe fielen
+} DisplayStatistik;
+
+// Priorität einer Einblendung (höhere verdrängt niedrigere)
+typedef enum {
+    DISPLAY_PRIO_INFO = 0,
+    DISPLAY_PRIO_WARNUNG = 1,
+    DISPLAY_PRIO_FEHLER = 2
+} DisplayPrioritaet;
+
+// Alarm-Bits des Anzeige-Schlüssels
+#define DISPLAY_ALARM_TEMP_HOCH 0x01
+#define DISPLAY_ALARM_TEMP_NIEDRIG 0x02
+#define DISPLAY_ALARM_TUER 0x04         // Tür länger als DOOR_OPEN_THRESHOLD offen
+#define DISPLAY_ALARM_ENERGIE 0x08
+#define DISPLAY_ALARM_UNGUELTIG 0x10    // Sensor-Daten ungültig
+
+// Eingaben der Sensor-Anzeige in Anzeige-Auflösung; gleicher Schlüssel
+// bedeutet gleiche Zeilen
+typedef struct {
+    long temperatur;                // Zehntel °C (wie angezeigt)
+    long energie;                   // Ganze Watt (wie angezeigt)
+    unsigned char tuer_offen;
+    unsigned char log_level;
+    unsigned char alarme;           // DISPLAY_ALARM_* Bits
+} DisplaySchluessel;
+
 // Globaler Display-Puffer
 extern DisplayPuffer display_puffer;
 
@@ -27,23 +78,91 @@ void display_initialisieren(void);
 
 /**
  * Aktualisiert das Display mit aktuellen Sensor-Daten
+ * Formatiert nur, wenn sich der Anzeige-Schlüssel geändert hat.
  * @param daten Aktuelle Sensor-Daten
  * @param log_level Aktuelles Log-Level (wird als erste Ziffer angezeigt)
  */
 void display_aktualisieren(const SensorDaten* daten, int log_level);
 
 /**
- * Zeigt eine Warnung auf dem Display an
+ * Ermittelt den Anzeige-Schlüssel zu Sensor-Daten und Log-Level
+ * @param daten Sensor-Daten
+ * @param log_level Aktuelles Log-Level
+ * @param schluessel Ergebnis
+ */
+void display_schluessel_berechnen(const SensorDaten* daten, int log_level, DisplaySchluessel* schluessel);
+
+/**
+ * Vergleicht zwei Anzeige-Schlüssel
+ * @return 1 wenn gleich, sonst 0
+ */
+int display_schluessel_gleich(const DisplaySchluessel* a, const DisplaySchluessel* b);
+
+/**
+ * Zeigt eine Warnung auf dem Display an (Einblendung in Zeile 2)
  * @param warnung_text Text der Warnung (max. 39 Zeichen)
  */
 void display_warnung_anzeigen(const char* warnung_text);
 
 /**
- * Zeigt eine Fehlermeldung auf dem Display an
+ * Zeigt eine Fehlermeldung auf dem Display an (Einblendung, beide Zeilen)
  * @param fehler_text Text der Fehlermeldung (max. 39 Zeichen)
  */
 void display_fehler_anzeigen(const char* fehler_text);
 
+/**
+ * Reiht eine zeitlich begrenzte Einblendung über der Sensor-Anzeige ein
+ * Angezeigt wird die Einblendung höchster Priorität (bei gleicher Priorität
+ * die älteste); ihre Dauer beginnt beim ersten Anzeigen. Eine gleiche,
+ * bereits vorhandene Einblendung wird nur verlängert.
+ * @param zeile1 Text der ersten Zeile oder NULL (Sensor-Zeile bleibt sichtbar)
+ * @param zeile2 Text der zweiten Zeile oder NULL
+ * @param dauer_ms Anzeigedauer (0 = bis display_overlays_leeren())
+ * @param prioritaet Priorität
+ * @return 1 wenn eingereiht, 0 wenn verworfen (Warteschlange voll)
+ */
+int display_overlay_zeigen(const char* zeile1, const char* zeile2, int dauer_ms,
+                           DisplayPrioritaet prioritaet);
+
+/**
+ * Entfernt abgelaufene Einblendungen und gibt die Anzeige aus (einmal pro
+ * Durchlauf der Hauptschleife). Alle Änderungen (Sensor-Werte, Einblendungen)
+ * markieren die Anzeige nur; ausgegeben wird hier, höchstens mit der
+ * eingestellten Bildrate. Blockiert nie.
+ */
+void display_zyklus(void);
+
+/**
+ * Zeit, bis display_zyklus() wieder etwas auszugeben hat
+ * (wartende Änderung oder ablaufende Einblendung)
+ * @param maximum Obergrenze in Millisekunden
+ * @return Wartezeit in Millisekunden (0 = sofort)
+ */
+int display_wartezeit_ms(int maximum);
+
+/**
+ * Setzt die maximale Bildrate der Ausgabe
+ * @param bilder_pro_sekunde 1..1000, 0 = jede Änderung sofort im nächsten Zyklus
+ * @return 1 bei Erfolg, 0 bei ungültigem Wert
+ */
+int display_bildrate_setzen(int bilder_pro_sekunde);
+
+/**
+ * Liefert die eingestellte Bildrate
+ * @return Bilder pro Sekunde (0 = unbegrenzt)
+ */
+int display_bildrate_abfragen(void);
+
+/**
+ * Verwirft alle Einblendungen
+ */
+void display_overlays_leeren(void);
+
+/**
+ * Liefert die Anzahl wartender bzw. angezeigter Einblendungen
+ */
+int display_overlay_anzahl(void);
+
 /**
  * Löscht das Display (beide Zeilen)
  */
@@ -65,13 +184,82 @@ void display_zeile1_formatieren(char* zeile, const SensorDaten* daten, int log_l
 void display_zeile2_formatieren(char* zeile, const SensorDaten* daten);
 
 /**
- * Gibt das Display auf der Konsole aus (für Debugging/Simulation)
+ * Hängt Text an eine Zeile an (ohne Terminierung, abgeschnitten bei DISPLAY_COLS)
+ * @param zeile Zeilenpuffer (min. 41 Zeichen)
+ * @param position Aktuelle Schreibposition
+ * @param text Anzuhängender Text
+ * @return Neue Schreibposition
+ */
+int display_text_anhaengen(char* zeile, int position, const char* text);
+
+/**
+ * Hängt eine Festkomma-Zahl an (z.B. wert 37, 1 Nachkommastelle: "3.7")
+ * @param zeile Zeilenpuffer (min. 41 Zeichen)
+ * @param position Aktuelle Schreibposition
+ * @param wert Wert in Einheiten der letzten Nachkommastelle
+ * @param nachkommastellen Anzahl Nachkommastellen (0 = ganze Zahl)
+ * @return Neue Schreibposition
+ */
+int display_festkomma_anhaengen(char* zeile, int position, long wert, int nachkommastellen);
+
+/**
+ * Rundet einen Messwert auf eine Festkomma-Zahl (Halbwerte zur geraden Zahl)
+ * @param wert Messwert
+ * @param nachkommastellen Anzahl Nachkommastellen
+ * @return Wert in Einheiten der letzten Nachkommastelle
+ */
+long display_festkomma(float wert, int nachkommastellen);
+
+/**
+ * Füllt eine Zeile ab der Position mit Leerzeichen auf und terminiert sie
+ * @param zeile Zeilenpuffer (min. 41 Zeichen)
+ * @param position Erste aufzufüllende Spalte
+ */
+void display_zeile_abschliessen(char* zeile, int position);
+
+/**
+ * Zeigt das Display auf der Konsole an (für Debugging/Simulation)
+ * Das physische Display gleicht display_panel_abgleichen() ab.
  */
 void display_ausgeben(void);
 
 /**
- * Schreibt Display-Inhalt in eine Datei (für externe Überwachung)
- * @param dateiname Pfad zur Ausgabe-Datei
+ * Überträgt die seit dem letzten Abgleich geänderten Zeichen an den Treiber
+ * @return Anzahl übertragener Bereiche (0 = Display unverändert)
+ */
+int display_panel_abgleichen(void);
+
+/**
+ * Ermittelt die geänderten Bereiche einer Zeile
+ * Bereiche mit höchstens DISPLAY_LAUF_MAX_LUECKE unveränderten Zeichen
+ * dazwischen werden zusammengefasst (spart eine Cursor-Positionierung).
+ * @param alt Bisheriger Inhalt (DISPLAY_COLS Zeichen)
+ * @param neu Neuer Inhalt (DISPLAY_COLS Zeichen)
+ * @param zeile Zeilennummer für die Ergebnisse
+ * @param laeufe Ergebnis-Array
+ * @param max_laeufe Größe des Ergebnis-Arrays
+ * @return Anzahl gefundener Bereiche
+ */
+int display_laeufe_berechnen(const char* alt, const char* neu, int zeile,
+                             DisplayLauf* laeufe, int max_laeufe);
+
+/**
+ * Setzt den Treiber des physischen Displays
+ * Der nächste Abgleich überträgt den vollständigen Inhalt.
+ * @param treiber Treiber oder NULL (nur Schatten-Puffer und Zähler)
+ */
+void display_treiber_setzen(const DisplayTreiber* treiber);
+
+/**
+ * Liefert die Zähler des Display-Abgleichs
+ * @param statistik Ziel-Struktur
+ */
+void display_statistik_abfragen(DisplayStatistik* statistik);
+
+/**
+ * Schreibt Display-Inhalt und angezeigte Werte als Status-Datensatz
+ * fester Größe (für externe Überwachung, siehe status_datei.h)
+ * @param dateiname Pfad zur Status-Datei
  */
 void display_in_datei_schreiben(const char* dateiname);
 
@@ -124,6 +312,19 @@ void display_beenden(void);
 // Hilfsmakros für Display-Formatierung
 #define DISPLAY_DATEI "Workspace/display.txt"
 #define LEER_ZEILE "                                        " // 40 Leerzeichen
+#define DISPLAY_LAUF_MAX_LUECKE 1      // Ein Zeichen kostet so viel wie eine Cursor-Positionierung
+#define DISPLAY_MAX_LAEUFE ((DISPLAY_COLS + 1) / 2)   // Pro Zeile
+
+// Einblendungen
+#define DISPLAY_OVERLAY_MAX 8
+#define DISPLAY_START_DAUER_MS 2000
+#define DISPLAY_SYSTEMINFO_DAUER_MS 3000
+#define DISPLAY_MELDUNG_DAUER_MS 2000
+#define DISPLAY_WARNUNG_DAUER_MS 3000
+#define DISPLAY_FEHLER_DAUER_MS 5000
+
+// Ausgabe
+#define DISPLAY_BILDRATE_STANDARD 10    // Bilder pro Sekunde
 
 // Spezielle Zeichen für Display (ASCII)
 #define GRAD_ZEICHEN 'C'        // °C wird als C dargestellt
@@ -0,0 +1,248 @@
+// Für mmap/ftruncate/localtime_r unter C99
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+
+#define LOG_KATEGORIE LOG_KAT_LOGGING
+
+#include "flugschreiber.h"
+#include "logging.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Eingeblendete Ringdatei
+static FlugschreiberKopf* kopf = NULL;
+static FlugschreiberEintrag* eintraege = NULL;
+static size_t abbild_groesse = 0;
+
+// Verhindert, dass der Compiler die Sequenznummer vor den Daten schreibt
+#ifdef __GNUC__
+#define SCHREIB_BARRIERE() __asm__ __volatile__("" ::: "memory")
+#else
+#define SCHREIB_BARRIERE() ((void)0)
+#endif
+
+static const char FLUGSCHREIBER_KENNUNG[8] = { 'S', 'F', 'F', 'L', 'U', 'G', '0', '1' };
+
+static int kopf_gueltig(const FlugschreiberKopf* k, size_t datei_groesse);
+static size_t ring_ausgeben(const FlugschreiberKopf* k, const FlugschreiberEintrag* ring,
+                            size_t max_eintraege, FlugschreiberAusgabe ausgabe, void* kontext);
+
+/**
+ * Öffnet oder erstellt die Ringdatei
+ */
+int flugschreiber_initialisieren(const char* pfad) {
+    size_t groesse = sizeof(FlugschreiberKopf) + FLUGSCHREIBER_EINTRAEGE * sizeof(FlugschreiberEintrag);
+
+    int fd = open(pfad, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        LOG_ERROR_F("Flugschreiber-Datei %s nicht verfügbar: %s", pfad, strerror(errno));
+        return 0;
+    }
+
+    struct stat datei_stat;
+    int vorhanden = (fstat(fd, &datei_stat) == 0 && (size_t)datei_stat.st_size == groesse);
+
+    if (!vorhanden && ftruncate(fd, (off_t)groesse) != 0) {
+        LOG_ERROR_F("Flugschreiber-Datei konnte nicht angelegt werden: %s", strerror(errno));
+        close(fd);
+        return 0;
+    }
+
+    void* abbild = mmap(NULL, groesse, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd); // Abbildung bleibt auch ohne Deskriptor gültig
+    if (abbild == MAP_FAILED) {
+        LOG_ERROR_F("Flugschreiber konnte nicht eingeblendet werden: %s", strerror(errno));
+        return 0;
+    }
+
+    kopf = (FlugschreiberKopf*)abbild;
+    eintraege = (FlugschreiberEintrag*)((char*)abbild + sizeof(FlugschreiberKopf));
+    abbild_groesse = groesse;
+
+    if (vorhanden && kopf_gueltig(kopf, groesse)) {
+        LOG_INFO_F("Flugschreiber fortgesetzt: %s (%llu Einträge bisher)",
+                   pfad, (unsigned long long)kopf->schreib_index);
+    } else {
+        memset(abbild, 0, groesse);
+        memcpy(kopf->kennung, FLUGSCHREIBER_KENNUNG, sizeof(kopf->kennung));
+        kopf->eintrag_groesse = sizeof(FlugschreiberEintrag);
+        kopf->eintrag_anzahl = FLUGSCHREIBER_EINTRAEGE;
+        kopf->schreib_index = 0;
+        LOG_INFO_F("Flugschreiber angelegt: %s (%d Einträge)", pfad, FLUGSCHREIBER_EINTRAEGE);
+    }
+
+    return 1;
+}
+
+/**
+ * Zeichnet einen Log-Eintrag auf
+ */
+void flugschreiber_aufzeichnen(LogKategorie kategorie, LogLevel level, const char* text) {
+    if (kopf == NULL) {
+        return;
+    }
+
+    uint64_t index = kopf->schreib_index;
+    FlugschreiberEintrag* eintrag = &eintraege[index % FLUGSCHREIBER_EINTRAEGE];
+
+    struct timespec jetzt;
+    clock_gettime(CLOCK_REALTIME, &jetzt);
+
+    size_t laenge = strlen(text);
+    if (laenge > sizeof(eintrag->text)) {
+        laenge = sizeof(eintrag->text);
+    }
+
+    // Slot als unvollständig markieren, Daten kopieren, dann freigeben
+    eintrag->sequenz = 0;
+    SCHREIB_BARRIERE();
+    eintrag->zeit_ms = (int64_t)jetzt.tv_sec * 1000 + jetzt.tv_nsec / 1000000;
+    eintrag->level = (uint8_t)level;
+    eintrag->kategorie = (uint8_t)kategorie;
+    eintrag->laenge = (uint16_t)laenge;
+    memcpy(eintrag->text, text, laenge);
+    SCHREIB_BARRIERE();
+    eintrag->sequenz = index + 1;
+    kopf->schreib_index = index + 1;
+}
+
+/**
+ * Gibt die letzten Einträge des laufenden Flugschreibers aus
+ */
+size_t flugschreiber_ausgeben(size_t max_eintraege, FlugschreiberAusgabe ausgabe, void* kontext) {
+    if (kopf == NULL) {
+        return 0;
+    }
+    return ring_ausgeben(kopf, eintraege, max_eintraege, ausgabe, kontext);
+}
+
+/**
+ * Liest eine Ringdatei nachträglich
+ */
+long flugschreiber_datei_ausgeben(const char* pfad, size_t max_eintraege,
+                                  FlugschreiberAusgabe ausgabe, void* kontext) {
+    int fd = open(pfad, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct stat datei_stat;
+    if (fstat(fd, &datei_stat) != 0 || (size_t)datei_stat.st_size < sizeof(FlugschreiberKopf)) {
+        close(fd);
+        return -1;
+    }
+
+    size_t groesse = (size_t)datei_stat.st_size;
+    void* abbild = mmap(NULL, groesse, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (abbild == MAP_FAILED) {
+        return -1;
+    }
+
+    long anzahl = -1;
+    const FlugschreiberKopf* k = (const FlugschreiberKopf*)abbild;
+    if (kopf_gueltig(k, groesse)) {
+        const FlugschreiberEintrag* ring =
+            (const FlugschreiberEintrag*)((const char*)abbild + sizeof(FlugschreiberKopf));
+        anzahl = (long)ring_ausgeben(k, ring, max_eintraege, ausgabe, kontext);
+    }
+
+    munmap(abbild, groesse);
+    return anzahl;
+}
+
+/**
+ * Callback: Zeile in eine Datei schreiben
+ */
+static void zeile_in_datei(const char* zeile, void* kontext) {
+    fputs(zeile, (FILE*)kontext);
+}
+
+/**
+ * Schreibt den Inhalt des Flugschreibers in eine Textdatei
+ */
+long flugschreiber_in_datei_sichern(const char* dateiname) {
+    if (kopf == NULL) {
+        return -1;
+    }
+
+    FILE* datei = fopen(dateiname, "w");
+    if (datei == NULL) {
+        LOG_WARNING_F("Flugschreiber-Dump %s nicht möglich: %s", dateiname, strerror(errno));
+        return -1;
+    }
+
+    size_t anzahl = ring_ausgeben(kopf, eintraege, 0, zeile_in_datei, datei);
+    fclose(datei);
+
+    LOG_INFO_F("Flugschreiber gesichert: %zu Einträge nach %s", anzahl, dateiname);
+    return (long)anzahl;
+}
+
+/**
+ * Blendet die Ringdatei aus
+ */
+void flugschreiber_beenden(void) {
+    if (kopf != NULL) {
+        munmap(kopf, abbild_groesse);
+        kopf = NULL;
+        eintraege = NULL;
+    }
+}
+
+/**
+ * Prüft Kennung und Geometrie einer Ringdatei
+ */
+static int kopf_gueltig(const FlugschreiberKopf* k, size_t datei_groesse) {
+    return memcmp(k->kennung, FLUGSCHREIBER_KENNUNG, sizeof(k->kennung)) == 0 &&
+           k->eintrag_groesse == sizeof(FlugschreiberEintrag) &&
+           k->eintrag_anzahl > 0 &&
+           datei_groesse >= sizeof(FlugschreiberKopf) + (size_t)k->eintrag_anzahl * sizeof(FlugschreiberEintrag);
+}
+
+/**
+ * Formatiert die gültigen Einträge eines Rings in zeitlicher Reihenfolge
+ */
+static size_t ring_ausgeben(const FlugschreiberKopf* k, const FlugschreiberEintrag* ring,
+                            size_t max_eintraege, FlugschreiberAusgabe ausgabe, void* kontext) {
+    uint64_t ende = k->schreib_index;
+    uint64_t anzahl_slots = k->eintrag_anzahl;
+    uint64_t start = (ende > anzahl_slots) ? ende - anzahl_slots : 0;
+    if (max_eintraege > 0 && ende - start > max_eintraege) {
+        start = ende - max_eintraege;
+    }
+
+    size_t ausgegeben = 0;
+    for (uint64_t i = start; i < ende; i++) {
+        const FlugschreiberEintrag* e = &ring[i % anzahl_slots];
+
+        // Überschriebene oder beim Absturz unvollständige Slots überspringen
+        if (e->sequenz != i + 1) {
+            continue;
+        }
+
+        time_t sekunden = (time_t)(e->zeit_ms / 1000);
+        struct tm zeitinfo;
+        char zeitstempel[32];
+        localtime_r(&sekunden, &zeitinfo);
+        strftime(zeitstempel, sizeof(zeitstempel), "%Y-%m-%d %H:%M:%S", &zeitinfo);
+
+        int laenge = e->laenge > sizeof(e->text) ? (int)sizeof(e->text) : (int)e->laenge;
+        char zeile[256];
+        snprintf(zeile, sizeof(zeile), "[%s.%03d] %s [%s]: %.*s\n",
+                 zeitstempel, (int)(e->zeit_ms % 1000),
+                 log_level_zu_string((LogLevel)e->level),
+                 log_kategorie_zu_string((LogKategorie)e->kategorie),
+                 laenge, e->text);
+        ausgabe(zeile, kontext);
+        ausgegeben++;
+    }
+
+    return ausgegeben;
+}
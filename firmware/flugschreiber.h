@@ -0,0 +1,91 @@
+#ifndef FLUGSCHREIBER_H
+#define FLUGSCHREIBER_H
+
+#include "config.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Flugschreiber für Log-Einträge
+// Hält die letzten Einträge aller Level (auch DEBUG) in einer per mmap
+// eingeblendeten Ringdatei. Die Datei überlebt einen Absturz des Prozesses
+// und kann nachträglich mit "smart_fridge --flugschreiber" gelesen werden.
+
+// Ein Eintrag im Ring (feste Größe, 128 Bytes)
+typedef struct {
+    uint64_t sequenz;               // Laufende Nummer + 1, 0 = Slot leer
+    int64_t zeit_ms;                // Zeitstempel (Unix-Zeit in Millisekunden)
+    uint8_t level;                  // LogLevel
+    uint8_t kategorie;              // LogKategorie
+    uint16_t laenge;                // Länge des Textes
+    char text[108];                 // Nachricht (gekürzt, nicht nullterminiert)
+} FlugschreiberEintrag;
+
+// Kopf der Ringdatei
+typedef struct {
+    char kennung[8];                // "SFFLUG01"
+    uint32_t eintrag_groesse;       // sizeof(FlugschreiberEintrag)
+    uint32_t eintrag_anzahl;        // Anzahl Slots im Ring
+    uint64_t schreib_index;         // Anzahl bisher geschriebener Einträge
+    uint8_t reserviert[40];         // Auffüllung auf 64 Bytes
+} FlugschreiberKopf;
+
+// Callback für die Ausgabe einer formatierten Zeile
+typedef void (*FlugschreiberAusgabe)(const char* zeile, void* kontext);
+
+// Funktionsdeklarationen
+
+/**
+ * Öffnet oder erstellt die Ringdatei und blendet sie ein
+ * Eine vorhandene Datei mit passender Geometrie wird fortgeschrieben,
+ * damit die Einträge vor einem Absturz erhalten bleiben.
+ * @param pfad Pfad der Ringdatei
+ * @return 1 bei Erfolg, 0 bei Fehler
+ */
+int flugschreiber_initialisieren(const char* pfad);
+
+/**
+ * Zeichnet einen Log-Eintrag auf (ein memcpy in den eingeblendeten Ring)
+ * @param kategorie Log-Kategorie
+ * @param level Log-Level
+ * @param text Formatierte Nachricht
+ */
+void flugschreiber_aufzeichnen(LogKategorie kategorie, LogLevel level, const char* text);
+
+/**
+ * Gibt die letzten Einträge des laufenden Flugschreibers aus
+ * @param max_eintraege Maximale Anzahl (0 = alle)
+ * @param ausgabe Callback pro Zeile
+ * @param kontext Wird an den Callback durchgereicht
+ * @return Anzahl ausgegebener Einträge
+ */
+size_t flugschreiber_ausgeben(size_t max_eintraege, FlugschreiberAusgabe ausgabe, void* kontext);
+
+/**
+ * Liest eine Ringdatei nachträglich (z.B. nach einem Absturz)
+ * @param pfad Pfad der Ringdatei
+ * @param max_eintraege Maximale Anzahl (0 = alle)
+ * @param ausgabe Callback pro Zeile
+ * @param kontext Wird an den Callback durchgereicht
+ * @return Anzahl ausgegebener Einträge oder -1 bei Fehler
+ */
+long flugschreiber_datei_ausgeben(const char* pfad, size_t max_eintraege,
+                                  FlugschreiberAusgabe ausgabe, void* kontext);
+
+/**
+ * Schreibt den Inhalt des Flugschreibers als Text in eine Datei
+ * @param dateiname Ziel-Datei
+ * @return Anzahl geschriebener Einträge oder -1 bei Fehler
+ */
+long flugschreiber_in_datei_sichern(const char* dateiname);
+
+/**
+ * Blendet die Ringdatei aus und schließt sie
+ */
+void flugschreiber_beenden(void);
+
+// Dateien des Flugschreibers
+#define FLUGSCHREIBER_DATEI "Workspace/flugschreiber.bin"
+#define FLUGSCHREIBER_DUMP_DATEI "Workspace/flugschreiber.txt"
+#define FLUGSCHREIBER_EINTRAEGE 2048    // 2048 * 128 Bytes = 256 KiB
+
+#endif // FLUGSCHREIBER_H
@@ -0,0 +1,54 @@
+#include "i2c_bus.h"
+
+// Aktives Backend und Zähler
+static const I2CBackend* aktives_backend = NULL;
+static I2CStatistik statistik = {0};
+
+/**
+ * Setzt das Backend des Busses
+ */
+void i2c_backend_setzen(const I2CBackend* backend) {
+    aktives_backend = backend;
+}
+
+/**
+ * Schreibt eine Transaktion auf den Bus
+ */
+int i2c_schreiben(uint8_t adresse, const uint8_t* daten, size_t laenge) {
+    if (aktives_backend == NULL) {
+        return -1;
+    }
+
+    int ergebnis = aktives_backend->schreiben(aktives_backend->kontext, adresse, daten, laenge);
+    statistik.transaktionen++;
+    if (ergebnis == 0) {
+        statistik.bytes += (unsigned long)laenge;
+    } else {
+        statistik.fehler++;
+    }
+    return ergebnis;
+}
+
+/**
+ * Wartet die angegebene Zeit
+ */
+void i2c_warten_us(unsigned int mikrosekunden) {
+    if (aktives_backend != NULL && aktives_backend->warten_us != NULL) {
+        aktives_backend->warten_us(aktives_backend->kontext, mikrosekunden);
+    }
+}
+
+/**
+ * Liefert die Zähler des Busses
+ */
+void i2c_statistik_abfragen(I2CStatistik* ziel) {
+    *ziel = statistik;
+}
+
+/**
+ * Setzt die Zähler zurück
+ */
+void i2c_statistik_zuruecksetzen(void) {
+    I2CStatistik leer = {0};
+    statistik = leer;
+}
@@ -0,0 +1,63 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include "config.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// I2C-Bus-Schicht für das Display
+// Geräte-Treiber (z.B. lcd_hd44780.c) schreiben über i2c_schreiben(); das
+// eigentliche Backend ist austauschbar (Linux i2c-dev, Simulation, ...).
+
+// Backend eines I2C-Busses
+typedef struct {
+    const char* name;
+    // Schreib-Transaktion: START, Adresse, Daten, STOP (0 = ok, -1 = NACK/Fehler)
+    int (*schreiben)(void* kontext, uint8_t adresse, const uint8_t* daten, size_t laenge);
+    // Wartezeit für Geräte-Befehle mit langer Ausführungszeit
+    void (*warten_us)(void* kontext, unsigned int mikrosekunden);
+    void* kontext;
+} I2CBackend;
+
+// Zähler des Busses
+typedef struct {
+    unsigned long transaktionen;    // Schreib-Transaktionen (START ... STOP)
+    unsigned long bytes;            // Übertragene Nutzdaten-Bytes (ohne Adresse)
+    unsigned long fehler;           // Fehlgeschlagene Transaktionen
+} I2CStatistik;
+
+// Funktionsdeklarationen
+
+/**
+ * Setzt das Backend des Busses
+ * @param backend Backend (muss gültig bleiben) oder NULL
+ */
+void i2c_backend_setzen(const I2CBackend* backend);
+
+/**
+ * Schreibt eine Transaktion auf den Bus
+ * @param adresse 7-Bit-Geräteadresse
+ * @param daten Zu schreibende Bytes
+ * @param laenge Anzahl Bytes
+ * @return 0 bei Erfolg, -1 bei Fehler oder ohne Backend
+ */
+int i2c_schreiben(uint8_t adresse, const uint8_t* daten, size_t laenge);
+
+/**
+ * Wartet die angegebene Zeit (im Simulator: nur Modellzeit)
+ * @param mikrosekunden Wartezeit
+ */
+void i2c_warten_us(unsigned int mikrosekunden);
+
+/**
+ * Liefert die Zähler des Busses
+ * @param statistik Ziel-Struktur
+ */
+void i2c_statistik_abfragen(I2CStatistik* statistik);
+
+/**
+ * Setzt die Zähler des Busses zurück
+ */
+void i2c_statistik_zuruecksetzen(void);
+
+#endif // I2C_BUS_H
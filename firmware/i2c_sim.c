@@ -0,0 +1,157 @@
+#include "i2c_sim.h"
+#include "lcd_hd44780.h"
+#include <string.h>
+
+// HD44780-Befehle, die das Modell auswertet
+#define HD44780_CLEAR 0x01
+#define HD44780_HOME 0x02
+#define HD44780_FUNCTION_SET 0x20
+#define HD44780_FUNCTION_8BIT 0x10
+#define HD44780_DDRAM_ADRESSE 0x80
+
+// DDRAM-Adressen der zweizeiligen Betriebsart
+#define DDRAM_ZEILE2 0x40
+#define DDRAM_ZEILEN_LAENGE 0x28
+
+// Zustand von Bus, Portexpander und Controller
+static struct {
+    uint8_t adresse;                // Adresse des PCF8574
+    unsigned long takt_hz;
+    uint8_t port;                   // Letzter Ausgangszustand des PCF8574
+    int vier_bit;                   // HD44780 im 4-Bit-Modus
+    int halbes_byte;                // Oberes Nibble bereits übernommen
+    uint8_t oberes_nibble;
+    uint8_t ddram_adresse;
+    char ddram[0x80];
+    I2CSimZeiten zeiten;
+} sim;
+
+static int sim_schreiben(void* kontext, uint8_t adresse, const uint8_t* daten, size_t laenge);
+static void sim_warten_us(void* kontext, unsigned int mikrosekunden);
+static void nibble_uebernehmen(int rs, uint8_t nibble);
+static void hd44780_ausfuehren(int rs, uint8_t wert);
+
+static const I2CBackend sim_backend = {
+    "simuliert (PCF8574 + HD44780)",
+    sim_schreiben,
+    sim_warten_us,
+    NULL
+};
+
+/**
+ * Setzt die Simulation zurück
+ */
+const I2CBackend* i2c_sim_initialisieren(uint8_t adresse, unsigned long takt_hz) {
+    memset(&sim, 0, sizeof(sim));
+    sim.adresse = adresse;
+    sim.takt_hz = takt_hz > 0 ? takt_hz : I2C_TAKT_STANDARD;
+    memset(sim.ddram, ' ', sizeof(sim.ddram));
+    return &sim_backend;
+}
+
+/**
+ * Liefert die modellierten Zeiten
+ */
+void i2c_sim_zeiten_abfragen(I2CSimZeiten* zeiten) {
+    *zeiten = sim.zeiten;
+}
+
+/**
+ * Liest eine Zeile aus dem simulierten DDRAM
+ */
+void i2c_sim_zeile_lesen(int zeile, char* puffer) {
+    const char* quelle = sim.ddram + (zeile == 0 ? 0 : DDRAM_ZEILE2);
+    memcpy(puffer, quelle, DISPLAY_COLS);
+    puffer[DISPLAY_COLS] = '\0';
+}
+
+/**
+ * Liefert den eingestellten Bus-Takt
+ */
+unsigned long i2c_sim_takt(void) {
+    return sim.takt_hz;
+}
+
+/**
+ * Schreib-Transaktion auf dem simulierten Bus
+ */
+static int sim_schreiben(void* kontext, uint8_t adresse, const uint8_t* daten, size_t laenge) {
+    (void)kontext;
+
+    // START + Adressbyte + Datenbytes (je 8 Bit + ACK) + STOP
+    uint64_t bits = 2 + 9 * (uint64_t)(1 + laenge);
+    sim.zeiten.bus_zeit_ns += bits * 1000000000ULL / sim.takt_hz;
+
+    if (adresse != sim.adresse) {
+        return -1; // Kein Gerät: Adressbyte wird nicht quittiert
+    }
+
+    for (size_t i = 0; i < laenge; i++) {
+        // Der HD44780 übernimmt D4-D7 bei der fallenden Flanke von EN
+        if ((sim.port & PCF8574_EN) && !(daten[i] & PCF8574_EN)) {
+            nibble_uebernehmen(sim.port & PCF8574_RS, (uint8_t)(sim.port >> 4));
+        }
+        sim.port = daten[i];
+    }
+    return 0;
+}
+
+/**
+ * Wartezeit des Treibers (nur Modellzeit)
+ */
+static void sim_warten_us(void* kontext, unsigned int mikrosekunden) {
+    (void)kontext;
+    sim.zeiten.warte_zeit_ns += (uint64_t)mikrosekunden * 1000ULL;
+}
+
+/**
+ * Setzt Nibbles im 4-Bit-Modus zu Bytes zusammen
+ */
+static void nibble_uebernehmen(int rs, uint8_t nibble) {
+    if (!sim.vier_bit) {
+        // 8-Bit-Modus nach dem Einschalten: D0-D3 sind nicht angeschlossen
+        hd44780_ausfuehren(rs, (uint8_t)(nibble << 4));
+        return;
+    }
+
+    if (!sim.halbes_byte) {
+        sim.oberes_nibble = nibble;
+        sim.halbes_byte = 1;
+        return;
+    }
+
+    sim.halbes_byte = 0;
+    hd44780_ausfuehren(rs, (uint8_t)((sim.oberes_nibble << 4) | nibble));
+}
+
+/**
+ * Führt einen HD44780-Befehl bzw. Datenzugriff aus
+ */
+static void hd44780_ausfuehren(int rs, uint8_t wert) {
+    if (rs) {
+        sim.ddram[sim.ddram_adresse & 0x7F] = (char)wert;
+        sim.ddram_adresse++;
+        // Zweizeiliger Modus: 0x27 -> 0x40, 0x67 -> 0x00
+        if (sim.ddram_adresse == DDRAM_ZEILEN_LAENGE) {
+            sim.ddram_adresse = DDRAM_ZEILE2;
+        } else if (sim.ddram_adresse == DDRAM_ZEILE2 + DDRAM_ZEILEN_LAENGE) {
+            sim.ddram_adresse = 0;
+        }
+        sim.zeiten.zeichen++;
+        return;
+    }
+
+    sim.zeiten.befehle++;
+    if (wert & HD44780_DDRAM_ADRESSE) {
+        sim.ddram_adresse = wert & 0x7F;
+    } else if (wert & HD44780_FUNCTION_SET) {
+        sim.vier_bit = !(wert & HD44780_FUNCTION_8BIT);
+        sim.halbes_byte = 0;
+    } else if (wert == HD44780_CLEAR) {
+        memset(sim.ddram, ' ', sizeof(sim.ddram));
+        sim.ddram_adresse = 0;
+    } else if ((wert & 0xFE) == HD44780_HOME) {
+        sim.ddram_adresse = 0;
+    }
+    // Übrige Befehle (Display an/aus, Entry Mode, ...) ändern den DDRAM nicht
+}
@@ -0,0 +1,54 @@
+#ifndef I2C_SIM_H
+#define I2C_SIM_H
+
+#include "config.h"
+#include "i2c_bus.h"
+#include <stdint.h>
+
+// Simulierter I2C-Bus mit PCF8574-Portexpander und HD44780-Controller
+// Modelliert die Übertragungszeit bei 100/400 kHz und dekodiert das
+// 4-Bit-Protokoll in ein DDRAM-Abbild, so dass Treiber und Display-Abgleich
+// ohne Hardware geprüft und gemessen werden können.
+
+// Takt-Raten
+#define I2C_TAKT_STANDARD 100000UL  // Standard-Mode 100 kHz
+#define I2C_TAKT_FAST 400000UL      // Fast-Mode 400 kHz
+
+// Modellierte Bus- und Controller-Zeiten
+typedef struct {
+    uint64_t bus_zeit_ns;           // Belegungszeit des Busses
+    uint64_t warte_zeit_ns;         // Wartezeiten des Treibers (Clear/Home)
+    unsigned long befehle;          // Ausgeführte HD44780-Befehle
+    unsigned long zeichen;          // Geschriebene DDRAM-Zeichen
+} I2CSimZeiten;
+
+// Funktionsdeklarationen
+
+/**
+ * Setzt Simulation und Modell-Zeit zurück und liefert das Backend
+ * @param adresse Adresse des simulierten PCF8574 (andere Adressen: NACK)
+ * @param takt_hz Bus-Takt (z.B. I2C_TAKT_STANDARD)
+ * @return Backend für i2c_backend_setzen()
+ */
+const I2CBackend* i2c_sim_initialisieren(uint8_t adresse, unsigned long takt_hz);
+
+/**
+ * Liefert die modellierten Zeiten
+ * @param zeiten Ziel-Struktur
+ */
+void i2c_sim_zeiten_abfragen(I2CSimZeiten* zeiten);
+
+/**
+ * Liest eine Zeile aus dem simulierten DDRAM
+ * @param zeile 0 oder 1
+ * @param puffer Ziel (min. DISPLAY_COLS + 1 Zeichen)
+ */
+void i2c_sim_zeile_lesen(int zeile, char* puffer);
+
+/**
+ * Liefert den eingestellten Bus-Takt
+ * @return Takt in Hz
+ */
+unsigned long i2c_sim_takt(void);
+
+#endif // I2C_SIM_H
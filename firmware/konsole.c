@@ -0,0 +1,224 @@
+// Für fcntl/poll unter C99
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+
+#include "konsole.h"
+#include "metriken.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+
+AusgabeModus ausgabe_modus = AUSGABE_BEIDE;
+
+// Wartende Konsolen-Daten liegen in puffer[anfang..ende)
+static char puffer[KONSOLE_PUFFER_GROESSE];
+static size_t anfang = 0;
+static size_t ende = 0;
+static KonsolenStatistik statistik = {0};
+static int stdout_defekt = 0;            // stdout geschlossen o.ä.: alles verwerfen
+
+// Wie geschrieben wird (siehe konsole.h)
+typedef enum {
+    SCHREIBEN_NICHT_BLOCKIEREND = 0,    // Eigene O_NONBLOCK-Öffnung oder reguläre Datei
+    SCHREIBEN_SOCKET,                   // send() mit MSG_DONTWAIT auf stdout
+    SCHREIBEN_BLOCKWEISE                // Notlösung: poll() und höchstens ein Block
+} SchreibArt;
+
+static int ausgabe_fd = STDOUT_FILENO;
+static SchreibArt schreib_art = SCHREIBEN_BLOCKWEISE;
+
+/**
+ * Setzt den Ausgabe-Modus
+ */
+void konsole_initialisieren(AusgabeModus modus) {
+    ausgabe_modus = modus;
+
+    metrik_zaehler_registrieren("konsole_verworfen_eintraege_total", NULL,
+                                "Wegen vollem Puffer verworfene Konsolen-Ausgaben (Log-Zeilen, Display)",
+                                &statistik.verworfene_eintraege);
+    metrik_zaehler_registrieren("konsole_verworfen_bytes_total", NULL, "Verworfene Konsolen-Bytes",
+                                &statistik.verworfene_bytes);
+
+    // Bisher über stdio gepufferte Ausgaben vor der Senke ausgeben
+    fflush(stdout);
+
+    if (!(modus & AUSGABE_KONSOLE)) {
+        return;
+    }
+
+    struct stat info;
+    if (fstat(STDOUT_FILENO, &info) != 0) {
+        stdout_defekt = 1;
+        return;
+    }
+    if (S_ISREG(info.st_mode)) {
+        // Dateien blockieren nicht; eigene Öffnung hätte einen eigenen Offset
+        schreib_art = SCHREIBEN_NICHT_BLOCKIEREND;
+        return;
+    }
+    if (S_ISSOCK(info.st_mode)) {
+        // z.B. journald-Stream; Sockets lassen sich nicht über /proc öffnen
+        schreib_art = SCHREIBEN_SOCKET;
+        return;
+    }
+
+    // Terminal, serielle Konsole, Pipe: neue Dateibeschreibung desselben
+    // Ziels, O_NONBLOCK betrifft damit nicht die Shell
+    int fd = open("/proc/self/fd/1", O_WRONLY | O_NONBLOCK | O_NOCTTY | O_CLOEXEC);
+    if (fd >= 0) {
+        ausgabe_fd = fd;
+        schreib_art = SCHREIBEN_NICHT_BLOCKIEREND;
+    }
+}
+
+/**
+ * Wandelt einen Modus-Namen um
+ */
+int ausgabe_modus_aus_string(const char* text, AusgabeModus* modus) {
+    if (strcmp(text, "datei") == 0) {
+        *modus = AUSGABE_DATEI;
+    } else if (strcmp(text, "konsole") == 0) {
+        *modus = AUSGABE_KONSOLE;
+    } else if (strcmp(text, "beide") == 0) {
+        *modus = AUSGABE_BEIDE;
+    } else if (strcmp(text, "keine") == 0) {
+        *modus = AUSGABE_KEINE;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Übergibt Daten an die Konsolen-Senke
+ */
+int konsole_schreiben(const char* daten, size_t laenge) {
+    if (!(ausgabe_modus & AUSGABE_KONSOLE) || laenge == 0) {
+        return 1;
+    }
+
+    if (stdout_defekt || laenge > sizeof(puffer) - (ende - anfang)) {
+        statistik.verworfene_bytes += laenge;
+        statistik.verworfene_eintraege++;
+        return 0;
+    }
+
+    // Platz am Ende schaffen, wenn der belegte Bereich nach hinten gewandert ist
+    if (laenge > sizeof(puffer) - ende) {
+        memmove(puffer, puffer + anfang, ende - anfang);
+        ende -= anfang;
+        anfang = 0;
+    }
+
+    memcpy(puffer + ende, daten, laenge);
+    ende += laenge;
+    return 1;
+}
+
+/**
+ * Formatierte Ausgabe über die Konsolen-Senke
+ */
+void konsole_printf(const char* format, ...) {
+    if (!(ausgabe_modus & AUSGABE_KONSOLE)) {
+        return;
+    }
+
+    char zeile[1024];
+    va_list args;
+    va_start(args, format);
+    int laenge = vsnprintf(zeile, sizeof(zeile), format, args);
+    va_end(args);
+
+    if (laenge > 0) {
+        konsole_schreiben(zeile, (size_t)laenge < sizeof(zeile) ? (size_t)laenge : sizeof(zeile) - 1);
+    }
+}
+
+/**
+ * Rest des Puffers verwerfen, stdout ist weg (z.B. EPIPE, EBADF, POLLHUP)
+ */
+static void stdout_aufgeben(void) {
+    stdout_defekt = 1;
+    statistik.verworfene_bytes += (unsigned long)(ende - anfang);
+    anfang = ende;
+}
+
+/**
+ * Schreibt wartende Daten ohne zu warten; der Rest bleibt im Puffer
+ */
+void konsole_abarbeiten(void) {
+    while (anfang < ende && !stdout_defekt) {
+        size_t laenge = ende - anfang;
+        ssize_t n;
+        if (schreib_art == SCHREIBEN_SOCKET) {
+            n = send(ausgabe_fd, puffer + anfang, laenge, MSG_DONTWAIT | MSG_NOSIGNAL);
+        } else if (schreib_art == SCHREIBEN_NICHT_BLOCKIEREND) {
+            n = write(ausgabe_fd, puffer + anfang, laenge);
+        } else {
+            struct pollfd pfd = { ausgabe_fd, POLLOUT, 0 };
+            if (poll(&pfd, 1, 0) <= 0 || !(pfd.revents & POLLOUT)) {
+                if (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) {
+                    stdout_aufgeben();
+                }
+                break;
+            }
+            n = write(ausgabe_fd, puffer + anfang,
+                      laenge < KONSOLE_SCHREIB_BLOCK ? laenge : KONSOLE_SCHREIB_BLOCK);
+        }
+
+        if (n > 0) {
+            anfang += (size_t)n;
+            statistik.geschriebene_bytes += (unsigned long)n;
+            if (schreib_art == SCHREIBEN_BLOCKWEISE) {
+                // Höchstens ein Block pro Durchlauf
+                break;
+            }
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            stdout_aufgeben();
+        }
+        break;
+    }
+
+    if (anfang == ende) {
+        anfang = 0;
+        ende = 0;
+    }
+}
+
+/**
+ * Liefert die Zähler der Konsolen-Senke
+ */
+void konsole_statistik_abfragen(KonsolenStatistik* ziel) {
+    *ziel = statistik;
+    ziel->puffer_belegt = ende - anfang;
+}
+
+/**
+ * Leert den Puffer bis zur Frist und schließt die eigene Öffnung von stdout
+ */
+void konsole_beenden(int frist_ms) {
+    int gewartet = 0;
+    konsole_abarbeiten();
+    while (anfang < ende && !stdout_defekt && gewartet < frist_ms) {
+        struct pollfd pfd = { ausgabe_fd, POLLOUT, 0 };
+        poll(&pfd, 1, 10);
+        gewartet += 10;
+        konsole_abarbeiten();
+    }
+
+    if (ausgabe_fd != STDOUT_FILENO) {
+        close(ausgabe_fd);
+        ausgabe_fd = STDOUT_FILENO;
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef KONSOLE_H
+#define KONSOLE_H
+
+#include "config.h"
+#include <stddef.h>
+
+// Konsolen-Ausgabe für Log und Display
+// Gepufferte, nicht blockierende Senke für stdout: kann der Empfänger
+// (serielle Konsole, journald, Pipe) nicht mithalten, wird verworfen und
+// gezählt statt die Hauptschleife zu blockieren. Die Flags von stdout
+// bleiben unverändert (die Dateibeschreibung teilt sich der Prozess mit
+// der aufrufenden Shell). Geschrieben wird über eine eigene, nicht
+// blockierende Öffnung desselben Ziels (/proc/self/fd/1), bei Sockets per
+// send(MSG_DONTWAIT); nicht angenommene Bytes bleiben im Puffer.
+
+// Ausgabe-Modi (Bitmaske)
+typedef enum {
+    AUSGABE_KEINE = 0,
+    AUSGABE_DATEI = 1,              // Log-Datei und Display-Datei
+    AUSGABE_KONSOLE = 2,            // Log-Zeilen und Display-Rahmen auf stdout
+    AUSGABE_BEIDE = 3
+} AusgabeModus;
+
+// Zähler der Konsolen-Senke
+typedef struct {
+    unsigned long geschriebene_bytes;   // An stdout übergeben
+    unsigned long verworfene_bytes;     // Wegen vollem Puffer verworfen
+    unsigned long verworfene_eintraege; // Verworfene Schreibaufrufe
+    size_t puffer_belegt;               // Aktuell wartende Bytes
+} KonsolenStatistik;
+
+// Aktueller Ausgabe-Modus (Standard: AUSGABE_BEIDE)
+extern AusgabeModus ausgabe_modus;
+
+// Funktionsdeklarationen
+
+/**
+ * Setzt den Ausgabe-Modus und registriert die Metriken der Senke
+ * @param modus Ausgabe-Modus
+ */
+void konsole_initialisieren(AusgabeModus modus);
+
+/**
+ * Wandelt "datei", "konsole", "beide" oder "keine" in einen Modus um
+ * @param text Name des Modus
+ * @param modus Ergebnis
+ * @return 1 bei Erfolg, 0 bei unbekanntem Namen
+ */
+int ausgabe_modus_aus_string(const char* text, AusgabeModus* modus);
+
+/**
+ * Übergibt Daten an die Konsolen-Senke (verwirft sie bei vollem Puffer)
+ * Geschrieben wird erst in konsole_abarbeiten()
+ * @param daten Auszugebende Bytes
+ * @param laenge Anzahl Bytes
+ * @return 1 wenn übernommen (oder Konsole aus), 0 wenn verworfen
+ */
+int konsole_schreiben(const char* daten, size_t laenge);
+
+/**
+ * Formatierte Ausgabe über die Konsolen-Senke
+ * @param format Printf-ähnliches Format
+ */
+void konsole_printf(const char* format, ...);
+
+/**
+ * Schreibt wartende Daten, soweit stdout sie ohne Warten annimmt
+ * Wird einmal pro Durchlauf der Hauptschleife aufgerufen
+ */
+void konsole_abarbeiten(void);
+
+/**
+ * Liefert die Zähler der Konsolen-Senke
+ * @param statistik Ziel-Struktur
+ */
+void konsole_statistik_abfragen(KonsolenStatistik* statistik);
+
+/**
+ * Versucht den Puffer bis zur Frist zu leeren und schließt den
+ * Ausgabe-Deskriptor
+ * @param frist_ms Maximale Wartezeit in Millisekunden
+ */
+void konsole_beenden(int frist_ms);
+
+// Größe des Konsolen-Puffers
+#define KONSOLE_PUFFER_GROESSE 65536
+
+// Nur falls stdout nicht nicht-blockierend geöffnet werden kann: höchstens
+// so viele Bytes pro write() nach poll(POLLOUT). Ohne Warten garantiert ist
+// das nur für Pipes (PIPE_BUF), ein Terminal kann trotzdem kurz blockieren.
+#define KONSOLE_SCHREIB_BLOCK 4096
+
+#endif // KONSOLE_H
@@ -0,0 +1,146 @@
+// Für clock_gettime unter C99
+#define _POSIX_C_SOURCE 200809L
+
+#include "latenz.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static int fach_von_wert(uint64_t wert);
+static uint64_t fach_obergrenze(int fach);
+static int dauer_formatieren(char* puffer, int groesse, uint64_t wert_us);
+
+/**
+ * Monotone Zeit in Mikrosekunden
+ */
+uint64_t latenz_jetzt_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+/**
+ * Erfasst einen Wert
+ */
+void latenz_erfassen(LatenzHistogramm* h, uint64_t wert_us) {
+    h->faecher[fach_von_wert(wert_us)]++;
+    h->anzahl++;
+    h->summe_us += wert_us;
+    if (wert_us > h->max_us) {
+        h->max_us = wert_us;
+    }
+}
+
+/**
+ * Schätzt ein Perzentil
+ */
+uint64_t latenz_perzentil(const LatenzHistogramm* h, double anteil) {
+    if (h->anzahl == 0) {
+        return 0;
+    }
+
+    // Rang des gesuchten Werts (1-basiert, aufgerundet)
+    unsigned long rang = (unsigned long)(anteil * (double)h->anzahl);
+    if ((double)rang < anteil * (double)h->anzahl) {
+        rang++;
+    }
+    if (rang < 1) {
+        rang = 1;
+    }
+
+    unsigned long kumuliert = 0;
+    for (int i = 0; i < LATENZ_FAECHER; i++) {
+        kumuliert += h->faecher[i];
+        if (kumuliert >= rang) {
+            uint64_t grenze = fach_obergrenze(i);
+            return grenze < h->max_us ? grenze : h->max_us;
+        }
+    }
+    return h->max_us;
+}
+
+/**
+ * Zählt die Werte bis zu einer Grenze
+ */
+unsigned long latenz_anzahl_bis(const LatenzHistogramm* h, uint64_t grenze_us) {
+    unsigned long summe = 0;
+    for (int i = 0; i < LATENZ_FAECHER && fach_obergrenze(i) <= grenze_us; i++) {
+        summe += h->faecher[i];
+    }
+    return summe;
+}
+
+/**
+ * Setzt ein Histogramm zurück
+ */
+void latenz_zuruecksetzen(LatenzHistogramm* h) {
+    memset(h, 0, sizeof(*h));
+}
+
+/**
+ * Formatiert p50/p99/max
+ */
+const char* latenz_zusammenfassung(const LatenzHistogramm* h, char* puffer, int groesse) {
+    int pos = snprintf(puffer, (size_t)groesse, "p50 ");
+    pos += dauer_formatieren(puffer + pos, groesse - pos, latenz_perzentil(h, 0.50));
+    pos += snprintf(puffer + pos, (size_t)(groesse - pos), " p99 ");
+    pos += dauer_formatieren(puffer + pos, groesse - pos, latenz_perzentil(h, 0.99));
+    pos += snprintf(puffer + pos, (size_t)(groesse - pos), " max ");
+    dauer_formatieren(puffer + pos, groesse - pos, h->max_us);
+    return puffer;
+}
+
+/**
+ * Fach eines Werts: linear unter LATENZ_LINEAR, darüber log-linear
+ */
+static int fach_von_wert(uint64_t wert) {
+    if (wert < LATENZ_LINEAR) {
+        return (int)wert;
+    }
+
+    int exponent = 63;
+    while (!(wert >> exponent)) {
+        exponent--;
+    }
+    if (exponent >= LATENZ_MAX_EXPONENT) {
+        return LATENZ_FAECHER - 1;
+    }
+
+    int unterfach = (int)((wert >> (exponent - LATENZ_UNTER_BITS)) & ((1 << LATENZ_UNTER_BITS) - 1));
+    return LATENZ_LINEAR + (exponent - LATENZ_UNTER_BITS - 1) * (1 << LATENZ_UNTER_BITS) + unterfach;
+}
+
+/**
+ * Größter Wert, der in ein Fach fällt
+ */
+static uint64_t fach_obergrenze(int fach) {
+    if (fach < LATENZ_LINEAR) {
+        return (uint64_t)fach;
+    }
+
+    int relativ = fach - LATENZ_LINEAR;
+    int exponent = relativ / (1 << LATENZ_UNTER_BITS) + LATENZ_UNTER_BITS + 1;
+    int unterfach = relativ % (1 << LATENZ_UNTER_BITS);
+    uint64_t breite = 1ULL << (exponent - LATENZ_UNTER_BITS);
+    uint64_t untergrenze = (uint64_t)((1 << LATENZ_UNTER_BITS) + unterfach) * breite;
+    return untergrenze + breite - 1;
+}
+
+/**
+ * Gibt eine Dauer in us, ms oder s aus
+ */
+static int dauer_formatieren(char* puffer, int groesse, uint64_t wert_us) {
+    if (groesse <= 0) {
+        return 0;
+    }
+
+    int laenge;
+    if (wert_us < 1000) {
+        laenge = snprintf(puffer, (size_t)groesse, "%uus", (unsigned int)wert_us);
+    } else if (wert_us < 1000000) {
+        laenge = snprintf(puffer, (size_t)groesse, "%.1fms", (double)wert_us / 1000.0);
+    } else {
+        laenge = snprintf(puffer, (size_t)groesse, "%.2fs", (double)wert_us / 1000000.0);
+    }
+    return laenge < groesse ? laenge : groesse - 1;
+}
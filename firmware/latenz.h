@@ -0,0 +1,73 @@
+#ifndef LATENZ_H
+#define LATENZ_H
+
+#include <stdint.h>
+
+// Latenz-Histogramme mit festen Fächern
+// Log-linear: Werte unter 16 us haben je ein eigenes Fach, darüber wird jede
+// Zweierpotenz in 8 gleich breite Fächer geteilt (relativer Fehler <= 12,5 %).
+// Erfassen ist O(1) und ohne Speicheranforderung.
+
+#define LATENZ_UNTER_BITS 3
+#define LATENZ_LINEAR (1 << (LATENZ_UNTER_BITS + 1))   // 16 exakte Fächer
+#define LATENZ_MAX_EXPONENT 32                          // Werte bis ~71 min
+#define LATENZ_FAECHER (LATENZ_LINEAR + \
+    (LATENZ_MAX_EXPONENT - LATENZ_UNTER_BITS - 1) * (1 << LATENZ_UNTER_BITS))
+
+// Histogramm in Mikrosekunden
+typedef struct {
+    uint32_t faecher[LATENZ_FAECHER];
+    unsigned long anzahl;
+    uint64_t summe_us;
+    uint64_t max_us;
+} LatenzHistogramm;
+
+// Funktionsdeklarationen
+
+/**
+ * Monotone Zeit in Mikrosekunden (CLOCK_MONOTONIC)
+ * @return Mikrosekunden seit einem beliebigen, festen Zeitpunkt
+ */
+uint64_t latenz_jetzt_us(void);
+
+/**
+ * Erfasst einen Wert
+ * @param histogramm Ziel
+ * @param wert_us Wert in Mikrosekunden (größere Werte landen im letzten Fach)
+ */
+void latenz_erfassen(LatenzHistogramm* histogramm, uint64_t wert_us);
+
+/**
+ * Schätzt ein Perzentil (Obergrenze des Fachs, höchstens das Maximum)
+ * @param histogramm Histogramm
+ * @param anteil Anteil zwischen 0 und 1 (z.B. 0.99)
+ * @return Wert in Mikrosekunden, 0 ohne Werte
+ */
+uint64_t latenz_perzentil(const LatenzHistogramm* histogramm, double anteil);
+
+/**
+ * Zählt die Werte bis zu einer Grenze (für kumulative Export-Fächer)
+ * Ein internes Fach zählt nur mit, wenn es vollständig unter der Grenze
+ * liegt; das Ergebnis ist also höchstens um ein Fach zu klein.
+ * @param histogramm Histogramm
+ * @param grenze_us Obergrenze in Mikrosekunden (einschließlich)
+ * @return Anzahl der Werte
+ */
+unsigned long latenz_anzahl_bis(const LatenzHistogramm* histogramm, uint64_t grenze_us);
+
+/**
+ * Setzt ein Histogramm zurück
+ * @param histogramm Histogramm
+ */
+void latenz_zuruecksetzen(LatenzHistogramm* histogramm);
+
+/**
+ * Formatiert p50/p99/max kompakt (z.B. "p50 120us p99 2.1ms max 4.0ms")
+ * @param histogramm Histogramm
+ * @param puffer Ziel
+ * @param groesse Größe des Ziels
+ * @return puffer
+ */
+const char* latenz_zusammenfassung(const LatenzHistogramm* histogramm, char* puffer, int groesse);
+
+#endif // LATENZ_H
@@ -0,0 +1,121 @@
+#define LOG_KATEGORIE LOG_KAT_DISPLAY
+
+#include "lcd_hd44780.h"
+#include "i2c_bus.h"
+#include "logging.h"
+
+// HD44780-Befehle
+#define HD44780_CLEAR 0x01
+#define HD44780_ENTRY_MODE 0x06         // Adresse erhöhen, nicht schieben
+#define HD44780_DISPLAY_AN 0x0C         // Display an, Cursor aus, kein Blinken
+#define HD44780_FUNCTION_4BIT_2ZEILEN 0x28
+#define HD44780_DDRAM_ADRESSE 0x80
+
+// DDRAM-Startadressen der Zeilen
+static const uint8_t zeilen_adresse[DISPLAY_ROWS] = { 0x00, 0x40 };
+
+static uint8_t lcd_adresse = LCD_I2C_ADRESSE;
+
+static int nibble_senden(uint8_t nibble, uint8_t flags);
+static int bytes_senden(const uint8_t* werte, int anzahl, uint8_t flags);
+
+static const DisplayTreiber lcd_treiber = {
+    "HD44780 über I2C",
+    lcd_cursor_setzen,
+    lcd_daten_schreiben
+};
+
+/**
+ * Initialisiert das Display im 4-Bit-Modus
+ */
+int lcd_initialisieren(uint8_t adresse) {
+    lcd_adresse = adresse;
+
+    // Nach dem Einschalten ist der Controller im 8-Bit-Modus; die Sequenz
+    // 3-3-3-2 schaltet aus jedem Zustand sicher in den 4-Bit-Modus
+    i2c_warten_us(40000);
+    if (nibble_senden(0x3, 0) != 0) {
+        LOG_ERROR_F("LCD antwortet nicht auf I2C-Adresse 0x%02X", adresse);
+        return 0;
+    }
+    i2c_warten_us(4100);
+    nibble_senden(0x3, 0);
+    i2c_warten_us(100);
+    nibble_senden(0x3, 0);
+    nibble_senden(0x2, 0);
+
+    lcd_befehl(HD44780_FUNCTION_4BIT_2ZEILEN);
+    lcd_befehl(HD44780_DISPLAY_AN);
+    lcd_befehl(HD44780_CLEAR);
+    i2c_warten_us(LCD_CLEAR_DAUER_US);
+    lcd_befehl(HD44780_ENTRY_MODE);
+
+    LOG_INFO_F("LCD initialisiert: HD44780 an 0x%02X", adresse);
+    return 1;
+}
+
+/**
+ * Sendet einen HD44780-Befehl
+ */
+void lcd_befehl(uint8_t befehl) {
+    bytes_senden(&befehl, 1, 0);
+}
+
+/**
+ * Setzt die DDRAM-Adresse
+ */
+void lcd_cursor_setzen(int zeile, int spalte) {
+    if (zeile < 0 || zeile >= DISPLAY_ROWS || spalte < 0 || spalte >= DISPLAY_COLS) {
+        return;
+    }
+    lcd_befehl((uint8_t)(HD44780_DDRAM_ADRESSE | (zeilen_adresse[zeile] + spalte)));
+}
+
+/**
+ * Schreibt Zeichen ab der aktuellen Cursor-Position
+ */
+void lcd_daten_schreiben(const char* daten, int laenge) {
+    while (laenge > 0) {
+        int teil = laenge < LCD_ZEICHEN_PRO_TRANSAKTION ? laenge : LCD_ZEICHEN_PRO_TRANSAKTION;
+        bytes_senden((const uint8_t*)daten, teil, PCF8574_RS);
+        daten += teil;
+        laenge -= teil;
+    }
+}
+
+/**
+ * Liefert den Treiber für den Display-Abgleich
+ */
+const DisplayTreiber* lcd_display_treiber(void) {
+    return &lcd_treiber;
+}
+
+/**
+ * Sendet ein einzelnes Nibble (nur während der Initialisierung)
+ */
+static int nibble_senden(uint8_t nibble, uint8_t flags) {
+    uint8_t port = (uint8_t)((nibble << 4) | flags | PCF8574_BL);
+    uint8_t puls[2] = { (uint8_t)(port | PCF8574_EN), port };
+    return i2c_schreiben(lcd_adresse, puls, sizeof(puls));
+}
+
+/**
+ * Sendet Bytes als Nibble-Paare in einer Transaktion
+ * Der Controller braucht pro Befehl/Zeichen 37 us; selbst bei 400 kHz
+ * liegen zwischen zwei EN-Flanken 45 us, Wartezeiten sind daher nicht nötig.
+ */
+static int bytes_senden(const uint8_t* werte, int anzahl, uint8_t flags) {
+    uint8_t puffer[LCD_ZEICHEN_PRO_TRANSAKTION * 4];
+    int laenge = 0;
+
+    for (int i = 0; i < anzahl; i++) {
+        uint8_t hoch = (uint8_t)((werte[i] & 0xF0) | flags | PCF8574_BL);
+        uint8_t tief = (uint8_t)(((werte[i] << 4) & 0xF0) | flags | PCF8574_BL);
+        puffer[laenge++] = (uint8_t)(hoch | PCF8574_EN);
+        puffer[laenge++] = hoch;
+        puffer[laenge++] = (uint8_t)(tief | PCF8574_EN);
+        puffer[laenge++] = tief;
+    }
+
+    return i2c_schreiben(lcd_adresse, puffer, (size_t)laenge);
+}
@@ -0,0 +1,64 @@
+#ifndef LCD_HD44780_H
+#define LCD_HD44780_H
+
+#include "config.h"
+#include "display.h"
+#include <stdint.h>
+
+// Treiber für HD44780-Zeichendisplays am PCF8574-I2C-Portexpander
+// 4-Bit-Modus: jedes Byte wird als zwei Nibbles mit je einem EN-Puls
+// übertragen (4 I2C-Bytes pro Zeichen bzw. Befehl).
+
+// Belegung des PCF8574 (übliches Backpack-Modul)
+#define PCF8574_RS 0x01             // P0: Register Select (0 = Befehl, 1 = Daten)
+#define PCF8574_RW 0x02             // P1: Read/Write (immer 0 = schreiben)
+#define PCF8574_EN 0x04             // P2: Enable, Übernahme bei fallender Flanke
+#define PCF8574_BL 0x08             // P3: Hintergrundbeleuchtung
+// P4-P7: Datenleitungen D4-D7
+
+// Standard-Adresse des PCF8574-Backpacks
+#define LCD_I2C_ADRESSE 0x27
+
+// Zeichen pro I2C-Transaktion (64 Bytes auf dem Bus)
+#define LCD_ZEICHEN_PRO_TRANSAKTION 16
+
+// Ausführungszeiten laut Datenblatt
+#define LCD_CLEAR_DAUER_US 1520
+#define LCD_BEFEHL_DAUER_US 37
+
+// Funktionsdeklarationen
+
+/**
+ * Initialisiert das Display im 4-Bit-Modus (2 Zeilen, Cursor aus, leer)
+ * @param adresse I2C-Adresse des PCF8574
+ * @return 1 bei Erfolg, 0 wenn das Gerät nicht antwortet
+ */
+int lcd_initialisieren(uint8_t adresse);
+
+/**
+ * Sendet einen HD44780-Befehl
+ * @param befehl Befehlsbyte
+ */
+void lcd_befehl(uint8_t befehl);
+
+/**
+ * Setzt die DDRAM-Adresse auf Zeile/Spalte
+ * @param zeile 0 oder 1
+ * @param spalte 0 bis DISPLAY_COLS - 1
+ */
+void lcd_cursor_setzen(int zeile, int spalte);
+
+/**
+ * Schreibt Zeichen ab der aktuellen Cursor-Position
+ * @param daten Zeichen
+ * @param laenge Anzahl Zeichen
+ */
+void lcd_daten_schreiben(const char* daten, int laenge);
+
+/**
+ * Liefert den Treiber für display_treiber_setzen()
+ * @return Treiber-Beschreibung
+ */
+const DisplayTreiber* lcd_display_treiber(void);
+
+#endif // LCD_HD44780_H
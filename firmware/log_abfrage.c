@@ -0,0 +1,236 @@
+// Für mmap/localtime_r unter C99
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+
+#include "log_abfrage.h"
+#include "logging.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Länge des Zeitstempels "JJJJ-MM-TT HH:MM:SS" am Zeilenanfang (nach '[')
+#define ZEITSTEMPEL_LAENGE 19
+
+static int datei_einblenden(const char* pfad, const char** daten, size_t* groesse);
+static long long start_offset_suchen(const char* index_pfad, time_t von,
+                                     const char* log, size_t log_groesse);
+static int zeilen_level(const char* zeile, size_t laenge);
+
+/**
+ * Führt eine Abfrage aus
+ */
+int log_abfrage_ausfuehren(const LogAbfrage* abfrage, FILE* ausgabe, LogAbfrageErgebnis* ergebnis) {
+    struct timespec start, ende;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    const char* log = NULL;
+    size_t log_groesse = 0;
+    if (!datei_einblenden(abfrage->log_pfad, &log, &log_groesse)) {
+        return 0;
+    }
+
+    // Zeitgrenzen im Format der Log-Zeilen; der Zeitstempel sortiert lexikographisch
+    char von_text[ZEITSTEMPEL_LAENGE + 1] = "";
+    char bis_text[ZEITSTEMPEL_LAENGE + 1] = "";
+    struct tm zeitinfo;
+    if (abfrage->von != 0) {
+        localtime_r(&abfrage->von, &zeitinfo);
+        strftime(von_text, sizeof(von_text), "%Y-%m-%d %H:%M:%S", &zeitinfo);
+    }
+    if (abfrage->bis != 0) {
+        localtime_r(&abfrage->bis, &zeitinfo);
+        strftime(bis_text, sizeof(bis_text), "%Y-%m-%d %H:%M:%S", &zeitinfo);
+    }
+
+    long long start_offset = 0;
+    if (abfrage->von != 0 && abfrage->index_pfad != NULL) {
+        start_offset = start_offset_suchen(abfrage->index_pfad, abfrage->von, log, log_groesse);
+    }
+
+    long treffer = 0;
+    size_t position = (size_t)start_offset;
+    while (position < log_groesse) {
+        const char* zeile = log + position;
+        const char* zeilenende = memchr(zeile, '\n', log_groesse - position);
+        size_t laenge = zeilenende ? (size_t)(zeilenende - zeile) + 1 : log_groesse - position;
+        position += laenge;
+
+        if (laenge < ZEITSTEMPEL_LAENGE + 2 || zeile[0] != '[') {
+            continue;
+        }
+        if (von_text[0] != '\0' && memcmp(zeile + 1, von_text, ZEITSTEMPEL_LAENGE) < 0) {
+            continue;
+        }
+        if (bis_text[0] != '\0' && memcmp(zeile + 1, bis_text, ZEITSTEMPEL_LAENGE) > 0) {
+            break; // Log ist zeitlich sortiert, dahinter kommt nichts Passendes mehr
+        }
+        if (abfrage->min_level >= 0 && zeilen_level(zeile, laenge) < abfrage->min_level) {
+            continue;
+        }
+
+        fwrite(zeile, 1, laenge, ausgabe);
+        treffer++;
+    }
+
+    if (log != NULL) {
+        munmap((void*)log, log_groesse);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &ende);
+    if (ergebnis != NULL) {
+        ergebnis->treffer = treffer;
+        ergebnis->gelesene_bytes = (long long)position - start_offset;
+        ergebnis->start_offset = start_offset;
+        ergebnis->dauer_ms = (double)(ende.tv_sec - start.tv_sec) * 1000.0 +
+                             (double)(ende.tv_nsec - start.tv_nsec) / 1e6;
+    }
+    return 1;
+}
+
+/**
+ * Wandelt eine Zeitangabe in time_t um
+ */
+int log_abfrage_zeit_parsen(const char* text, time_t* zeit) {
+    struct tm zeitinfo;
+    memset(&zeitinfo, 0, sizeof(zeitinfo));
+
+    int felder = sscanf(text, "%d-%d-%d %d:%d:%d",
+                        &zeitinfo.tm_year, &zeitinfo.tm_mon, &zeitinfo.tm_mday,
+                        &zeitinfo.tm_hour, &zeitinfo.tm_min, &zeitinfo.tm_sec);
+    if (felder != 3 && felder != 5 && felder != 6) {
+        return 0;
+    }
+
+    zeitinfo.tm_year -= 1900;
+    zeitinfo.tm_mon -= 1;
+    zeitinfo.tm_isdst = -1;
+
+    time_t ergebnis = mktime(&zeitinfo);
+    if (ergebnis == (time_t)-1) {
+        return 0;
+    }
+    *zeit = ergebnis;
+    return 1;
+}
+
+/**
+ * Wandelt einen Level-Namen um
+ */
+int log_abfrage_level_parsen(const char* text) {
+    if (text[0] >= '0' && text[0] <= '3' && text[1] == '\0') {
+        return text[0] - '0';
+    }
+
+    for (int level = LOG_DEBUG; level <= LOG_ERROR; level++) {
+        if (strcmp(text, log_level_zu_string((LogLevel)level)) == 0) {
+            return level;
+        }
+    }
+
+    // Englische Namen wie in den Makros
+    if (strcmp(text, "WARNING") == 0) return LOG_WARNING;
+    if (strcmp(text, "ERROR") == 0) return LOG_ERROR;
+    return -1;
+}
+
+/**
+ * Blendet eine Datei schreibgeschützt ein
+ * Eine leere Datei ergibt daten == NULL und groesse == 0
+ */
+static int datei_einblenden(const char* pfad, const char** daten, size_t* groesse) {
+    *daten = NULL;
+    *groesse = 0;
+
+    int fd = open(pfad, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+
+    struct stat datei_stat;
+    if (fstat(fd, &datei_stat) != 0) {
+        close(fd);
+        return 0;
+    }
+    if (datei_stat.st_size == 0) {
+        close(fd);
+        return 1;
+    }
+
+    void* abbild = mmap(NULL, (size_t)datei_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (abbild == MAP_FAILED) {
+        return 0;
+    }
+
+    // Die Abfrage liest sequentiell ab dem Startpunkt
+    madvise(abbild, (size_t)datei_stat.st_size, MADV_SEQUENTIAL);
+
+    *daten = (const char*)abbild;
+    *groesse = (size_t)datei_stat.st_size;
+    return 1;
+}
+
+/**
+ * Sucht per Binärsuche den letzten Index-Eintrag vor "von"
+ * Alle Log-Einträge vor diesem Offset sind älter als "von".
+ */
+static long long start_offset_suchen(const char* index_pfad, time_t von,
+                                     const char* log, size_t log_groesse) {
+    const char* abbild = NULL;
+    size_t index_groesse = 0;
+    if (!datei_einblenden(index_pfad, &abbild, &index_groesse) || abbild == NULL) {
+        return 0; // Kein Index: lineare Suche ab Dateianfang
+    }
+
+    const LogIndexEintrag* index = (const LogIndexEintrag*)abbild;
+    size_t anzahl = index_groesse / sizeof(LogIndexEintrag);
+
+    // Erster Eintrag mit zeit >= von
+    size_t links = 0;
+    size_t rechts = anzahl;
+    while (links < rechts) {
+        size_t mitte = links + (rechts - links) / 2;
+        if (index[mitte].zeit < (int64_t)von) {
+            links = mitte + 1;
+        } else {
+            rechts = mitte;
+        }
+    }
+
+    long long offset = 0;
+    if (links > 0) {
+        uint64_t kandidat = index[links - 1].offset;
+        // Nur Offsets auf einem Zeilenanfang innerhalb der Datei verwenden
+        if (kandidat < log_groesse && (kandidat == 0 || log[kandidat - 1] == '\n')) {
+            offset = (long long)kandidat;
+        }
+    }
+
+    munmap((void*)abbild, index_groesse);
+    return offset;
+}
+
+/**
+ * Ermittelt das Level einer Log-Zeile "[zeitstempel] LEVEL [KATEGORIE]: ..."
+ */
+static int zeilen_level(const char* zeile, size_t laenge) {
+    size_t start = ZEITSTEMPEL_LAENGE + 3; // '[' + Zeitstempel + "] "
+    if (laenge <= start) {
+        return -1;
+    }
+
+    for (int level = LOG_DEBUG; level <= LOG_ERROR; level++) {
+        const char* name = log_level_zu_string((LogLevel)level);
+        size_t name_laenge = strlen(name);
+        if (laenge > start + name_laenge &&
+            memcmp(zeile + start, name, name_laenge) == 0 &&
+            zeile[start + name_laenge] == ' ') {
+            return level;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,55 @@
+#ifndef LOG_ABFRAGE_H
+#define LOG_ABFRAGE_H
+
+#include "config.h"
+#include <stdio.h>
+#include <time.h>
+
+// Zeitbasierte Abfrage der Log-Datei
+// Blendet Log-Datei und Zeit-Index per mmap ein, springt per Binärsuche im
+// Index an den Anfang des Zeitfensters und liest nur den betroffenen Bereich.
+
+// Parameter einer Abfrage
+typedef struct {
+    const char* log_pfad;           // Log-Datei
+    const char* index_pfad;         // Zeit-Index (darf fehlen)
+    time_t von;                     // Beginn des Zeitfensters (0 = Dateianfang)
+    time_t bis;                     // Ende des Zeitfensters inkl. (0 = Dateiende)
+    int min_level;                  // Mindest-Level 0-3 (-1 = alle)
+} LogAbfrage;
+
+// Ergebnis-Statistik einer Abfrage
+typedef struct {
+    long treffer;                   // Ausgegebene Zeilen
+    long long gelesene_bytes;       // Untersuchter Bereich der Log-Datei
+    long long start_offset;         // Per Index ermittelter Startpunkt
+    double dauer_ms;                // Laufzeit der Abfrage
+} LogAbfrageErgebnis;
+
+// Funktionsdeklarationen
+
+/**
+ * Führt eine Abfrage aus und schreibt passende Zeilen nach "ausgabe"
+ * @param abfrage Parameter der Abfrage
+ * @param ausgabe Ziel für die gefundenen Zeilen
+ * @param ergebnis Statistik (darf NULL sein)
+ * @return 1 bei Erfolg, 0 wenn die Log-Datei nicht lesbar ist
+ */
+int log_abfrage_ausfuehren(const LogAbfrage* abfrage, FILE* ausgabe, LogAbfrageErgebnis* ergebnis);
+
+/**
+ * Wandelt "JJJJ-MM-TT HH:MM[:SS]" (lokale Zeit) in time_t um
+ * @param text Zeitangabe
+ * @param zeit Ergebnis
+ * @return 1 bei Erfolg, 0 bei ungültigem Format
+ */
+int log_abfrage_zeit_parsen(const char* text, time_t* zeit);
+
+/**
+ * Wandelt einen Level-Namen (DEBUG, INFO, WARNUNG, FEHLER) oder eine Ziffer um
+ * @param text Level-Angabe
+ * @return Level 0-3 oder -1 wenn unbekannt
+ */
+int log_abfrage_level_parsen(const char* text);
+
+#endif // LOG_ABFRAGE_H
@@ -1,82 +1,532 @@
+// Für open/fstat/ftruncate unter C99
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+
+#define LOG_KATEGORIE LOG_KAT_LOGGING
+
 #include "logging.h"
+#include "metriken.h"
+#include "flugschreiber.h"
+#include "konsole.h"
+#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <signal.h>
 #include <time.h>
+#include <fcntl.h>
 #include <unistd.h>
+#include <sys/stat.h>
 
 // Globale Variablen für das Logging-System
 LogLevel aktuelle_log_stufe = LOG_INFO;  // Standard Log-Level
+uint32_t log_freigabe_maske = 0xEEEEEu;  // Ausgabe- oder Aufzeichnungs-Freigabe
+static uint32_t log_ausgabe_maske = 0xEEEEEu;   // INFO und höher in allen 5 Kategorien
+static uint32_t log_aufzeichnungs_maske = 0;    // Flugschreiber (alle Level wenn aktiv)
 static FILE* log_datei = NULL;           // Log-Datei Handle
+static volatile sig_atomic_t log_fd = -1;  // Deskriptor von log_datei für logging_notfall_sichern()
 static int letzter_taster_zustand = 0;   // Für Taster-Entprellung
 
+// Gruppen-Commit der Log-Datei (siehe LogDauerhaftigkeit)
+static char log_puffer[LOG_PUFFER_GROESSE];
+static LogDauerhaftigkeit dauerhaftigkeit = {
+    LOG_DAUER_BATCH, LOG_SYNC_INTERVALL_MS, LOG_SYNC_EINTRAEGE, 1
+};
+static int log_ungeleert = 0;                   // Daten im stdio-Puffer
+static unsigned int eintraege_seit_sync = 0;    // Seit letztem fdatasync geschrieben
+static long long letzter_sync_ms = 0;
+
+// Zeit-Index der Log-Datei (siehe LogIndexEintrag)
+static int log_index_fd = -1;
+static long long log_offset = 0;         // Aktuelle Größe der Log-Datei in Bytes
+static time_t letzter_index_zeitpunkt = 0;
+static unsigned int eintraege_seit_index = 0;
+
+// Freigabe-Bits einer Kategorie für "Level und höher"
+#define LOG_KATEGORIE_BITS(level) ((0xFu << (unsigned)(level)) & 0xFu)
+#define LOG_KATEGORIE_MASKE(kat) (0xFu << ((unsigned)(kat) * 4u))
+
+#define LOG_ALLE_BITS 0xFFFFFu                   // Alle Level in allen Kategorien
+
+// Zusammenfassung wiederholter Meldungen: je Kategorie wird nur mit der
+// zuletzt ausgegebenen Meldung verglichen (Hash), Wiederholungen nur gezählt.
+// Eine andere Meldung schließt die Serie vorher ab, damit die Reihenfolge
+// im Log erhalten bleibt.
+typedef struct {
+    uint64_t hash;                       // FNV-1a über Kategorie, Level und Text
+    unsigned long anzahl;                // Unterdrückte Wiederholungen seit letzter Ausgabe
+    time_t erste_wiederholung;           // Beginn der aktuellen Wiederholungsserie
+    time_t zuletzt_gesehen;              // Letztes Auftreten (0 = Slot frei)
+    uint8_t kategorie;
+    uint8_t level;
+    char text[96];                       // Anfang der Meldung für die Zusammenfassung
+} LogWiederholung;
+
+static LogWiederholung wiederholungen[LOG_KAT_ANZAHL];
+static LogStatistik log_statistik = {0};
+static time_t letzte_wiederholungs_pruefung = 0;
+
+static void log_verarbeiten(LogKategorie kategorie, LogLevel level, const char* nachricht);
+static void log_ausgeben(LogKategorie kategorie, LogLevel level, const char* nachricht, time_t jetzt);
+static int log_wiederholung_erkennen(LogKategorie kategorie, LogLevel level,
+                                     const char* nachricht, time_t jetzt);
+static void log_wiederholung_abschliessen(LogWiederholung* slot, time_t jetzt);
+static void log_index_oeffnen(void);
+static void log_index_fortschreiben(time_t zeitpunkt);
+static void log_datei_sichern(int synchronisieren);
+static long long monotone_ms(void);
+
 /**
  * Initialisiert das Logging-System
  */
 void logging_initialisieren(void) {
     // Log-Datei öffnen (append mode)
-    log_datei = fopen("kuehlschrank.log", "a");
+    log_datei = fopen(LOG_DATEI, "a");
     if (log_datei == NULL) {
         fprintf(stderr, "FEHLER: Konnte Log-Datei nicht öffnen!\n");
         log_datei = stderr; // Fallback auf stderr
+    } else {
+        // Voll gepuffert; geleert wird gemäß Dauerhaftigkeits-Regel
+        setvbuf(log_datei, log_puffer, _IOFBF, sizeof(log_puffer));
+        log_fd = fileno(log_datei);
+        log_index_oeffnen();
+        letzter_sync_ms = monotone_ms();
     }
     
+    metrik_zaehler_registrieren("log_eintraege_total", NULL, "Geschriebene Log-Zeilen",
+                                &log_statistik.geschrieben);
+    metrik_zaehler_registrieren("log_unterdrueckt_total", NULL, "Als Wiederholung unterdrückte Meldungen",
+                                &log_statistik.unterdrueckt);
+    metrik_zaehler_registrieren("log_flushes_total", NULL, "Übergaben des Log-Puffers an das Betriebssystem",
+                                &log_statistik.flushes);
+    metrik_zaehler_registrieren("log_syncs_total", NULL, "fdatasync-Aufrufe der Log-Datei",
+                                &log_statistik.syncs);
+    
     // Initialisierungs-Nachricht loggen
-    log_nachricht(LOG_INFO, "=== Kühlschrank Firmware gestartet ===");
-    log_formatiert(LOG_INFO, "Log-Level initialisiert auf: %s", 
-                   log_level_zu_string(aktuelle_log_stufe));
+    LOG_INFO_MSG("=== Kühlschrank Firmware gestartet ===");
+    LOG_INFO_F("Log-Level initialisiert auf: %s", 
+               log_level_zu_string(aktuelle_log_stufe));
 }
 
 /**
- * Schreibt eine Log-Nachricht mit Zeitstempel
+ * Schreibt eine Log-Nachricht mit Zeitstempel (Kategorie SYSTEM)
  */
 void log_nachricht(LogLevel level, const char* nachricht) {
-    // Prüfen ob Nachricht geloggt werden soll
-    if (level < aktuelle_log_stufe) {
+    if (!LOG_AKTIV(LOG_KAT_SYSTEM, level)) {
+        return;
+    }
+    log_verarbeiten(LOG_KAT_SYSTEM, level, nachricht);
+}
+
+/**
+ * Schreibt eine formatierte Log-Nachricht (Kategorie SYSTEM)
+ */
+void log_formatiert(LogLevel level, const char* format, ...) {
+    if (!LOG_AKTIV(LOG_KAT_SYSTEM, level)) {
+        return;
+    }
+    
+    // Variable Argumente verarbeiten
+    va_list args;
+    char puffer[512];
+    
+    va_start(args, format);
+    vsnprintf(puffer, sizeof(puffer), format, args);
+    va_end(args);
+    
+    log_verarbeiten(LOG_KAT_SYSTEM, level, puffer);
+}
+
+/**
+ * Schreibt eine Log-Nachricht in einer bestimmten Kategorie
+ */
+void log_kategorie_nachricht(LogKategorie kategorie, LogLevel level, const char* nachricht) {
+    if (kategorie >= LOG_KAT_ANZAHL || !LOG_AKTIV(kategorie, level)) {
+        return;
+    }
+    log_verarbeiten(kategorie, level, nachricht);
+}
+
+/**
+ * Schreibt eine formatierte Log-Nachricht in einer bestimmten Kategorie
+ */
+void log_kategorie_formatiert(LogKategorie kategorie, LogLevel level, const char* format, ...) {
+    if (kategorie >= LOG_KAT_ANZAHL || !LOG_AKTIV(kategorie, level)) {
+        return;
+    }
+    
+    va_list args;
+    char puffer[512];
+    
+    va_start(args, format);
+    vsnprintf(puffer, sizeof(puffer), format, args);
+    va_end(args);
+    
+    log_verarbeiten(kategorie, level, puffer);
+}
+
+/**
+ * Verteilt eine Nachricht an Flugschreiber und Ausgabe
+ */
+static void log_verarbeiten(LogKategorie kategorie, LogLevel level, const char* nachricht) {
+    uint32_t bit = LOG_BIT(kategorie, level);
+    
+    if (log_aufzeichnungs_maske & bit) {
+        flugschreiber_aufzeichnen(kategorie, level, nachricht);
+    }
+    if (log_ausgabe_maske & bit) {
+        time_t jetzt = time(NULL);
+        if (log_wiederholung_erkennen(kategorie, level, nachricht, jetzt)) {
+            log_statistik.unterdrueckt++;
+            return;
+        }
+        log_ausgeben(kategorie, level, nachricht, jetzt);
+    }
+}
+
+/**
+ * Prüft ob eine Meldung die letzte Meldung ihrer Kategorie wiederholt
+ * Fehler werden nie zusammengefasst.
+ * @return 1 wenn die Meldung unterdrückt werden soll
+ */
+static int log_wiederholung_erkennen(LogKategorie kategorie, LogLevel level,
+                                     const char* nachricht, time_t jetzt) {
+    LogWiederholung* slot = &wiederholungen[kategorie];
+    if (level == LOG_ERROR) {
+        // Offene Serie vor dem Fehler ausgeben, der Fehler selbst beginnt keine
+        log_wiederholung_abschliessen(slot, jetzt);
+        slot->zuletzt_gesehen = 0;
+        return 0;
+    }
+
+    // FNV-1a, 64 Bit
+    uint64_t hash = 14695981039346656037ULL;
+    hash = (hash ^ (uint64_t)kategorie) * 1099511628211ULL;
+    hash = (hash ^ (uint64_t)level) * 1099511628211ULL;
+    for (const unsigned char* p = (const unsigned char*)nachricht; *p != '\0'; p++) {
+        hash = (hash ^ *p) * 1099511628211ULL;
+    }
+    
+    if (slot->zuletzt_gesehen != 0 && slot->hash == hash) {
+        if (slot->anzahl == 0) {
+            slot->erste_wiederholung = jetzt;
+        }
+        slot->anzahl++;
+        slot->zuletzt_gesehen = jetzt;
+        return 1;
+    }
+    
+    // Andere Meldung: laufende Serie zuerst abschließen, dann übernehmen
+    log_wiederholung_abschliessen(slot, jetzt);
+    slot->hash = hash;
+    slot->anzahl = 0;
+    slot->zuletzt_gesehen = jetzt;
+    slot->kategorie = (uint8_t)kategorie;
+    slot->level = (uint8_t)level;
+    strncpy(slot->text, nachricht, sizeof(slot->text) - 1);
+    slot->text[sizeof(slot->text) - 1] = '\0';
+    return 0;
+}
+
+/**
+ * Gibt die Zusammenfassung einer Wiederholungsserie aus
+ */
+static void log_wiederholung_abschliessen(LogWiederholung* slot, time_t jetzt) {
+    if (slot->anzahl == 0) {
+        return;
+    }
+    
+    char zusammenfassung[160];
+    snprintf(zusammenfassung, sizeof(zusammenfassung), "Letzte Meldung %lu-mal wiederholt: %s",
+             slot->anzahl, slot->text);
+    log_ausgeben((LogKategorie)slot->kategorie, (LogLevel)slot->level, zusammenfassung, jetzt);
+    log_statistik.zusammenfassungen++;
+    slot->anzahl = 0;
+}
+
+/**
+ * Periodische Wartung des Logging-Systems
+ */
+void logging_zyklus(void) {
+    // Gruppen-Commit: alle Einträge dieses Durchlaufs auf einmal übergeben
+    if (dauerhaftigkeit.stufe == LOG_DAUER_SYNC) {
+        log_datei_sichern(monotone_ms() - letzter_sync_ms >= dauerhaftigkeit.sync_intervall_ms);
+    } else if (dauerhaftigkeit.stufe == LOG_DAUER_BATCH) {
+        log_datei_sichern(0);
+    }
+    
+    time_t jetzt = time(NULL);
+    if (jetzt == letzte_wiederholungs_pruefung) {
+        return;
+    }
+    letzte_wiederholungs_pruefung = jetzt;
+    
+    for (int i = 0; i < LOG_KAT_ANZAHL; i++) {
+        LogWiederholung* slot = &wiederholungen[i];
+        if (slot->zuletzt_gesehen == 0) {
+            continue;
+        }
+        
+        if (jetzt - slot->zuletzt_gesehen > LOG_WIEDERHOLUNG_PAUSE) {
+            // Serie beendet: Zusammenfassung ausgeben und Slot freigeben
+            log_wiederholung_abschliessen(slot, jetzt);
+            slot->zuletzt_gesehen = 0;
+        } else if (slot->anzahl > 0 && jetzt - slot->erste_wiederholung >= LOG_WIEDERHOLUNG_MAX_SEKUNDEN) {
+            // Lang anhaltende Serie: regelmäßig ein Lebenszeichen ausgeben
+            log_wiederholung_abschliessen(slot, jetzt);
+        }
+    }
+}
+
+/**
+ * Zeit bis zur nächsten zeitgesteuerten Synchronisation
+ */
+int logging_wartezeit_ms(int maximum) {
+    if (dauerhaftigkeit.stufe != LOG_DAUER_SYNC || eintraege_seit_sync == 0) {
+        return maximum;
+    }
+    long long warten = letzter_sync_ms + dauerhaftigkeit.sync_intervall_ms - monotone_ms();
+    if (warten > maximum) {
+        return maximum;
+    }
+    return warten > 0 ? (int)warten : 0;
+}
+
+/**
+ * Leert den stdio-Puffer und synchronisiert optional mit dem Datenträger
+ */
+static void log_datei_sichern(int synchronisieren) {
+    if (log_datei == NULL || log_datei == stderr) {
         return;
     }
     
+    if (log_ungeleert) {
+        fflush(log_datei);
+        log_ungeleert = 0;
+        log_statistik.flushes++;
+    }
+    
+    if (synchronisieren && eintraege_seit_sync > 0) {
+        fdatasync(fileno(log_datei));
+        eintraege_seit_sync = 0;
+        log_statistik.syncs++;
+    }
+    if (synchronisieren) {
+        letzter_sync_ms = monotone_ms();
+    }
+}
+
+/**
+ * Monotone Zeit in Millisekunden
+ */
+static long long monotone_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/**
+ * Setzt die Dauerhaftigkeits-Regel
+ */
+void log_dauerhaftigkeit_setzen(const LogDauerhaftigkeit* regel) {
+    dauerhaftigkeit = *regel;
+    if (dauerhaftigkeit.sync_intervall_ms <= 0) {
+        dauerhaftigkeit.sync_intervall_ms = LOG_SYNC_INTERVALL_MS;
+    }
+    if (dauerhaftigkeit.sync_eintraege <= 0) {
+        dauerhaftigkeit.sync_eintraege = LOG_SYNC_EINTRAEGE;
+    }
+    
+    // Strengere Regel gilt ab sofort auch für bereits gepufferte Einträge
+    log_datei_sichern(dauerhaftigkeit.stufe == LOG_DAUER_SYNC);
+    
+    LOG_INFO_F("Log-Dauerhaftigkeit: %s (Sync alle %d ms / %d Einträge, FEHLER sofort: %s)",
+               log_dauer_stufe_zu_string(dauerhaftigkeit.stufe),
+               dauerhaftigkeit.sync_intervall_ms, dauerhaftigkeit.sync_eintraege,
+               dauerhaftigkeit.fehler_sofort ? "ja" : "nein");
+}
+
+/**
+ * Liefert die aktuelle Dauerhaftigkeits-Regel
+ */
+void log_dauerhaftigkeit_abfragen(LogDauerhaftigkeit* regel) {
+    *regel = dauerhaftigkeit;
+}
+
+/**
+ * Wandelt eine Dauerhaftigkeits-Angabe um
+ */
+int log_dauerhaftigkeit_aus_string(const char* text, LogDauerhaftigkeit* regel) {
+    if (strcmp(text, "keine") == 0) {
+        regel->stufe = LOG_DAUER_KEINE;
+        return 1;
+    }
+    if (strcmp(text, "batch") == 0) {
+        regel->stufe = LOG_DAUER_BATCH;
+        return 1;
+    }
+    if (strncmp(text, "sync", 4) != 0 || (text[4] != '\0' && text[4] != ':')) {
+        return 0;
+    }
+    
+    int intervall_ms = LOG_SYNC_INTERVALL_MS;
+    int eintraege = LOG_SYNC_EINTRAEGE;
+    if (text[4] == ':') {
+        char rest;
+        int felder = sscanf(text + 5, "%d:%d%c", &intervall_ms, &eintraege, &rest);
+        if (felder != 1 && felder != 2) {
+            return 0;
+        }
+        if (intervall_ms <= 0 || eintraege <= 0) {
+            return 0;
+        }
+    }
+    
+    regel->stufe = LOG_DAUER_SYNC;
+    regel->sync_intervall_ms = intervall_ms;
+    regel->sync_eintraege = eintraege;
+    return 1;
+}
+
+/**
+ * Liefert den Namen einer Dauerhaftigkeits-Stufe
+ */
+const char* log_dauer_stufe_zu_string(LogDauerStufe stufe) {
+    switch (stufe) {
+        case LOG_DAUER_KEINE: return "keine";
+        case LOG_DAUER_BATCH: return "batch";
+        case LOG_DAUER_SYNC:  return "sync";
+        default:              return "unbekannt";
+    }
+}
+
+/**
+ * Liefert die Zähler des Logging-Systems
+ */
+void log_statistik_abfragen(LogStatistik* statistik) {
+    *statistik = log_statistik;
+}
+
+/**
+ * Aktiviert oder deaktiviert die Aufzeichnung im Flugschreiber
+ */
+void log_aufzeichnung_aktivieren(int aktiv) {
+    log_aufzeichnungs_maske = aktiv ? LOG_ALLE_BITS : 0;
+    log_freigabe_maske = log_ausgabe_maske | log_aufzeichnungs_maske;
+}
+
+/**
+ * Schreibt eine bereits gefilterte Nachricht mit Zeitstempel
+ */
+static void log_ausgeben(LogKategorie kategorie, LogLevel level, const char* nachricht, time_t jetzt) {
     // Zeitstempel erstellen
-    time_t jetzt;
     struct tm* zeitinfo;
     char zeitstempel[64];
     
-    time(&jetzt);
     zeitinfo = localtime(&jetzt);
     strftime(zeitstempel, sizeof(zeitstempel), "%Y-%m-%d %H:%M:%S", zeitinfo);
     
-    // Log-Nachricht formatieren und ausgeben
-    const char* level_str = log_level_zu_string(level);
+    // Log-Zeile einmal formatieren, dann an Datei und Konsole verteilen
+    char zeile[640];
+    int laenge = snprintf(zeile, sizeof(zeile), "[%s] %s [%s]: %s\n", zeitstempel,
+                          log_level_zu_string(level), log_kategorie_zu_string(kategorie), nachricht);
+    if (laenge < 0) {
+        return;
+    }
+    if ((size_t)laenge >= sizeof(zeile)) {
+        laenge = (int)sizeof(zeile) - 1;
+        zeile[laenge - 1] = '\n';
+    }
+    log_statistik.geschrieben++;
     
     // In Datei schreiben
-    if (log_datei != NULL) {
-        fprintf(log_datei, "[%s] %s: %s\n", zeitstempel, level_str, nachricht);
-        fflush(log_datei); // Sofort schreiben für Debugging
+    if (log_datei != NULL && (ausgabe_modus & AUSGABE_DATEI)) {
+        log_index_fortschreiben(jetzt);
+        log_offset += (long long)fwrite(zeile, 1, (size_t)laenge, log_datei);
+        log_ungeleert = 1;
+        eintraege_seit_sync++;
+        
+        if (level == LOG_ERROR && dauerhaftigkeit.fehler_sofort) {
+            log_datei_sichern(1); // Fehler samt Vorgeschichte sofort sichern
+        } else if (dauerhaftigkeit.stufe == LOG_DAUER_SYNC &&
+                   eintraege_seit_sync >= (unsigned int)dauerhaftigkeit.sync_eintraege) {
+            log_datei_sichern(1);
+        }
     }
     
-    // Auch auf Konsole ausgeben für Entwicklung
-    printf("[%s] %s: %s\n", zeitstempel, level_str, nachricht);
+    // Auch auf Konsole ausgeben (nicht blockierend, siehe konsole.h)
+    konsole_schreiben(zeile, (size_t)laenge);
 }
 
 /**
- * Schreibt eine formatierte Log-Nachricht
+ * Öffnet den Zeit-Index und gleicht ihn mit der Log-Datei ab
  */
-void log_formatiert(LogLevel level, const char* format, ...) {
-    if (level < aktuelle_log_stufe) {
+static void log_index_oeffnen(void) {
+    struct stat log_stat;
+    if (fstat(fileno(log_datei), &log_stat) != 0) {
         return;
     }
+    log_offset = (long long)log_stat.st_size;
     
-    // Variable Argumente verarbeiten
-    va_list args;
-    char puffer[512];
+    log_index_fd = open(LOG_INDEX_DATEI, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (log_index_fd < 0) {
+        return; // Ohne Index funktioniert die Abfrage weiterhin (linear)
+    }
     
-    va_start(args, format);
-    vsnprintf(puffer, sizeof(puffer), format, args);
-    va_end(args);
+    // Einträge hinter dem Dateiende stammen von einer rotierten oder
+    // gekürzten Log-Datei und werden verworfen
+    struct stat index_stat;
+    if (fstat(log_index_fd, &index_stat) == 0) {
+        off_t anzahl = index_stat.st_size / (off_t)sizeof(LogIndexEintrag);
+        LogIndexEintrag letzter;
+        if (anzahl > 0 &&
+            pread(log_index_fd, &letzter, sizeof(letzter), (anzahl - 1) * (off_t)sizeof(letzter)) == sizeof(letzter) &&
+            letzter.offset > (uint64_t)log_offset) {
+            if (ftruncate(log_index_fd, 0) != 0) {
+                close(log_index_fd);
+                log_index_fd = -1;
+            }
+        } else if (index_stat.st_size % (off_t)sizeof(LogIndexEintrag) != 0) {
+            // Unvollständiger letzter Eintrag (Absturz beim Schreiben)
+            if (ftruncate(log_index_fd, anzahl * (off_t)sizeof(LogIndexEintrag)) != 0) {
+                close(log_index_fd);
+                log_index_fd = -1;
+            }
+        }
+    }
+    
+    // Erster Eintrag des Laufs wird sofort indiziert
+    letzter_index_zeitpunkt = 0;
+    eintraege_seit_index = LOG_INDEX_EINTRAEGE;
+}
+
+/**
+ * Schreibt bei Bedarf einen Index-Eintrag für den nächsten Log-Eintrag
+ */
+static void log_index_fortschreiben(time_t zeitpunkt) {
+    if (log_index_fd < 0) {
+        return;
+    }
+    
+    eintraege_seit_index++;
+    if (eintraege_seit_index < LOG_INDEX_EINTRAEGE &&
+        zeitpunkt - letzter_index_zeitpunkt < LOG_INDEX_SEKUNDEN) {
+        return;
+    }
+    
+    // Zeit im Index monoton halten, damit die Binärsuche gültig bleibt
+    if (zeitpunkt < letzter_index_zeitpunkt) {
+        zeitpunkt = letzter_index_zeitpunkt;
+    }
     
-    // An normale Log-Funktion weiterleiten
-    log_nachricht(level, puffer);
+    LogIndexEintrag eintrag;
+    eintrag.zeit = (int64_t)zeitpunkt;
+    eintrag.offset = (uint64_t)log_offset;
+    if (write(log_index_fd, &eintrag, sizeof(eintrag)) == (ssize_t)sizeof(eintrag)) {
+        letzter_index_zeitpunkt = zeitpunkt;
+        eintraege_seit_index = 0;
+    }
 }
 
 /**
@@ -85,14 +535,22 @@ void log_formatiert(LogLevel level, const char* format, ...) {
 void log_level_setzen(int neues_level) {
     // Gültigkeit prüfen
     if (neues_level < LOG_DEBUG || neues_level > LOG_ERROR) {
-        log_formatiert(LOG_WARNING, "Ungültiges Log-Level: %d. Behalte aktuelles Level bei.", neues_level);
+        LOG_WARNING_F("Ungültiges Log-Level: %d. Behalte aktuelles Level bei.", neues_level);
         return;
     }
     
     LogLevel altes_level = aktuelle_log_stufe;
     aktuelle_log_stufe = (LogLevel)neues_level;
     
-    log_formatiert(LOG_INFO, "Log-Level geändert von %s zu %s", 
+    // Alle Kategorien folgen dem globalen Level
+    uint32_t maske = 0;
+    for (int kat = 0; kat < LOG_KAT_ANZAHL; kat++) {
+        maske |= LOG_KATEGORIE_BITS(neues_level) << (kat * 4);
+    }
+    log_ausgabe_maske = maske;
+    log_freigabe_maske = log_ausgabe_maske | log_aufzeichnungs_maske;
+    
+    LOG_INFO_F("Log-Level geändert von %s zu %s", 
                    log_level_zu_string(altes_level), 
                    log_level_zu_string(aktuelle_log_stufe));
 }
@@ -104,6 +562,87 @@ int log_level_abfragen(void) {
     return (int)aktuelle_log_stufe;
 }
 
+/**
+ * Setzt das Log-Level einer einzelnen Kategorie
+ */
+int log_kategorie_level_setzen(LogKategorie kategorie, int neues_level) {
+    if (kategorie >= LOG_KAT_ANZAHL || neues_level < LOG_DEBUG || neues_level > LOG_ERROR) {
+        LOG_WARNING_F("Ungültige Kategorie/Level: %d/%d", (int)kategorie, neues_level);
+        return 0;
+    }
+    
+    int altes_level = log_kategorie_level_abfragen(kategorie);
+    log_ausgabe_maske = (log_ausgabe_maske & ~LOG_KATEGORIE_MASKE(kategorie)) |
+                        (LOG_KATEGORIE_BITS(neues_level) << ((unsigned)kategorie * 4u));
+    log_freigabe_maske = log_ausgabe_maske | log_aufzeichnungs_maske;
+    
+    LOG_INFO_F("Log-Level der Kategorie %s geändert von %s zu %s",
+               log_kategorie_zu_string(kategorie),
+               log_level_zu_string((LogLevel)altes_level),
+               log_level_zu_string((LogLevel)neues_level));
+    return 1;
+}
+
+/**
+ * Gibt das Log-Level einer Kategorie zurück
+ */
+int log_kategorie_level_abfragen(LogKategorie kategorie) {
+    if (kategorie >= LOG_KAT_ANZAHL) {
+        return (int)aktuelle_log_stufe;
+    }
+    
+    uint32_t bits = (log_ausgabe_maske >> ((unsigned)kategorie * 4u)) & 0xFu;
+    for (int level = LOG_DEBUG; level <= LOG_ERROR; level++) {
+        if (bits & (1u << level)) {
+            return level;
+        }
+    }
+    return LOG_ERROR;
+}
+
+/**
+ * Wandelt einen Kategorie-Namen in die Kategorie um
+ */
+LogKategorie log_kategorie_aus_string(const char* name) {
+    if (name == NULL) {
+        return LOG_KAT_ANZAHL;
+    }
+    
+    for (int kat = 0; kat < LOG_KAT_ANZAHL; kat++) {
+        const char* referenz = log_kategorie_zu_string((LogKategorie)kat);
+        size_t i = 0;
+        while (name[i] != '\0' && referenz[i] != '\0' &&
+               toupper((unsigned char)name[i]) == referenz[i]) {
+            i++;
+        }
+        if (name[i] == '\0' && referenz[i] == '\0') {
+            return (LogKategorie)kat;
+        }
+    }
+    return LOG_KAT_ANZAHL;
+}
+
+/**
+ * Konvertiert Log-Kategorie zu lesbarem String
+ */
+const char* log_kategorie_zu_string(LogKategorie kategorie) {
+    switch (kategorie) {
+        case LOG_KAT_SENSOR:  return "SENSOR";
+        case LOG_KAT_DISPLAY: return "DISPLAY";
+        case LOG_KAT_ALARM:   return "ALARM";
+        case LOG_KAT_SYSTEM:  return "SYSTEM";
+        case LOG_KAT_LOGGING: return "LOGGING";
+        default:              return "UNBEKANNT";
+    }
+}
+
+/**
+ * Erhöht das Log-Level zyklisch
+ */
+void log_level_weiterschalten(void) {
+    log_level_setzen(((int)aktuelle_log_stufe + 1) % 4);
+}
+
 /**
  * Überprüft Taster und erhöht Log-Level stufenweise
  */
@@ -123,9 +662,7 @@ void taster_pruefen_und_log_level_erhoehen(void) {
     if (fscanf(taster_datei, "%d", &taster_zustand) == 1) {
         // Taster-Entprellung: nur bei steigender Flanke reagieren
         if (taster_zustand == 1 && letzter_taster_zustand == 0) {
-            // Log-Level erhöhen (zyklisch)
-            int neues_level = ((int)aktuelle_log_stufe + 1) % 4;
-            log_level_setzen(neues_level);
+            log_level_weiterschalten();
             
             // Taster zurücksetzen
             fclose(taster_datei);
@@ -159,10 +696,64 @@ const char* log_level_zu_string(LogLevel level) {
  * Beendet das Logging-System ordnungsgemäß
  */
 void logging_beenden(void) {
-    log_nachricht(LOG_INFO, "=== Kühlschrank Firmware beendet ===");
+    // Offene Wiederholungsserien nicht verschweigen
+    for (int i = 0; i < LOG_KAT_ANZAHL; i++) {
+        log_wiederholung_abschliessen(&wiederholungen[i], time(NULL));
+    }
     
+    LOG_INFO_MSG("=== Kühlschrank Firmware beendet ===");
+    
+    log_datei_sichern(dauerhaftigkeit.stufe != LOG_DAUER_KEINE);
     if (log_datei != NULL && log_datei != stderr) {
+        log_fd = -1;
         fclose(log_datei);
         log_datei = NULL;
     }
+    
+    if (log_index_fd >= 0) {
+        close(log_index_fd);
+        log_index_fd = -1;
+    }
+}
+
+/**
+ * Synchronisiert die bereits übergebenen Log-Daten (async-signal-sicher)
+ */
+void logging_notfall_sichern(void) {
+    int fd = log_fd;
+    if (fd >= 0) {
+        fdatasync(fd);
+    }
+}
+
+/**
+ * Öffnet Log-Datei und Zeit-Index neu
+ * Nach einer Rotation schreibt die Firmware sonst weiter in die umbenannte
+ * Datei; der Index wird beim Öffnen mit der neuen Datei abgeglichen.
+ */
+void logging_neu_oeffnen(void) {
+    log_datei_sichern(dauerhaftigkeit.stufe != LOG_DAUER_KEINE);
+    if (log_datei != NULL && log_datei != stderr) {
+        log_fd = -1;
+        fclose(log_datei);
+    }
+    if (log_index_fd >= 0) {
+        close(log_index_fd);
+        log_index_fd = -1;
+    }
+    
+    log_datei = fopen(LOG_DATEI, "a");
+    if (log_datei == NULL) {
+        fprintf(stderr, "FEHLER: Konnte Log-Datei nicht neu öffnen!\n");
+        log_datei = stderr;
+        return;
+    }
+    setvbuf(log_datei, log_puffer, _IOFBF, sizeof(log_puffer));
+    log_fd = fileno(log_datei);
+    log_index_oeffnen();
+    log_ungeleert = 0;
+    eintraege_seit_sync = 0;
+    letzter_sync_ms = monotone_ms();
+    
+    LOG_INFO_MSG("Log-Datei neu geöffnet");
 }
@@ -3,6 +3,7 @@
 
 #include "config.h"
 #include <stdio.h>
+#include <stdint.h>
 #include <time.h>
 
 // Logging-System für Smart Kühlschrank Firmware
@@ -11,6 +12,66 @@
 // Globale Variable für aktuelles Log-Level (wird in config.h deklariert)
 // extern LogLevel aktuelle_log_stufe; // Bereits in config.h definiert
 
+// Kategorie des einbindenden Moduls. Module, die nicht unter SYSTEM loggen,
+// definieren LOG_KATEGORIE vor dem ersten #include.
+#ifndef LOG_KATEGORIE
+#define LOG_KATEGORIE LOG_KAT_SYSTEM
+#endif
+
+// Freigabe-Maske: 4 Bits pro Kategorie, Bit (kategorie * 4 + level) gesetzt
+// wenn das Level in dieser Kategorie ausgegeben oder im Flugschreiber
+// aufgezeichnet wird. Alle Kategorien passen in ein 32-Bit-Wort, die Prüfung
+// am Aufrufort ist ein einziges AND.
+extern uint32_t log_freigabe_maske;
+
+#define LOG_BIT(kat, level) (1u << ((unsigned)(kat) * 4u + (unsigned)(level)))
+#define LOG_AKTIV(kat, level) ((log_freigabe_maske & LOG_BIT(kat, level)) != 0u)
+
+// Log-Datei und ihr dünn besetzter Zeit-Index
+#define LOG_DATEI "kuehlschrank.log"
+#define LOG_INDEX_DATEI "kuehlschrank.log.idx"
+#define LOG_INDEX_SEKUNDEN 10        // Index-Eintrag spätestens alle 10 Sekunden
+#define LOG_INDEX_EINTRAEGE 256      // ... oder alle 256 Log-Einträge
+
+// Ein Index-Eintrag: Byte-Offset des ersten Log-Eintrags ab Zeitpunkt "zeit".
+// Die Zeiten im Index sind monoton steigend.
+typedef struct {
+    int64_t zeit;                    // Unix-Zeit des Log-Eintrags
+    uint64_t offset;                 // Byte-Offset in LOG_DATEI
+} LogIndexEintrag;
+
+// Zusammenfassung wiederholter Meldungen
+#define LOG_WIEDERHOLUNG_PAUSE 3             // Serie endet nach 3 s ohne Wiederholung
+#define LOG_WIEDERHOLUNG_MAX_SEKUNDEN 60     // Zusammenfassung spätestens alle 60 s
+
+// Zähler des Logging-Systems
+typedef struct {
+    unsigned long geschrieben;       // Ausgegebene Log-Zeilen
+    unsigned long unterdrueckt;      // Als Wiederholung unterdrückte Meldungen
+    unsigned long zusammenfassungen; // "Letzte Meldung N-mal wiederholt"-Zeilen
+    unsigned long flushes;           // Übergaben des stdio-Puffers an das Betriebssystem
+    unsigned long syncs;             // fdatasync()-Aufrufe (Gruppen-Commits)
+} LogStatistik;
+
+// Dauerhaftigkeit der Log-Datei: Abwägung zwischen Flash-Verschleiß,
+// Durchsatz und Verlustfenster bei Stromausfall oder Absturz
+typedef enum {
+    LOG_DAUER_KEINE = 0,    // stdio-Puffer (16 KiB) wird nur bei Bedarf geleert
+    LOG_DAUER_BATCH = 1,    // Einmal pro Hauptschleifen-Durchlauf leeren (Standard)
+    LOG_DAUER_SYNC = 2      // Wie BATCH, zusätzlich fdatasync alle N ms oder N Einträge
+} LogDauerStufe;
+
+typedef struct {
+    LogDauerStufe stufe;
+    int sync_intervall_ms;  // LOG_DAUER_SYNC: spätestens nach dieser Zeit synchronisieren
+    int sync_eintraege;     // LOG_DAUER_SYNC: spätestens nach so vielen Einträgen
+    int fehler_sofort;      // FEHLER-Einträge sofort leeren und synchronisieren
+} LogDauerhaftigkeit;
+
+#define LOG_PUFFER_GROESSE 16384
+#define LOG_SYNC_INTERVALL_MS 1000
+#define LOG_SYNC_EINTRAEGE 64
+
 // Funktionsdeklarationen
 
 /**
@@ -20,14 +81,14 @@
 void logging_initialisieren(void);
 
 /**
- * Schreibt eine Log-Nachricht mit angegebenem Level
+ * Schreibt eine Log-Nachricht mit angegebenem Level (Kategorie SYSTEM)
  * @param level Log-Level (DEBUG, INFO, WARNING, ERROR)
  * @param nachricht Die zu loggende Nachricht
  */
 void log_nachricht(LogLevel level, const char* nachricht);
 
 /**
- * Schreibt eine formatierte Log-Nachricht
+ * Schreibt eine formatierte Log-Nachricht (Kategorie SYSTEM)
  * @param level Log-Level
  * @param format Printf-ähnliches Format
  * @param ... Variable Argumente für Format
@@ -35,7 +96,24 @@ void log_nachricht(LogLevel level, const char* nachricht);
 void log_formatiert(LogLevel level, const char* format, ...);
 
 /**
- * Setzt das aktuelle Log-Level
+ * Schreibt eine Log-Nachricht in einer bestimmten Kategorie
+ * @param kategorie Log-Kategorie
+ * @param level Log-Level
+ * @param nachricht Die zu loggende Nachricht
+ */
+void log_kategorie_nachricht(LogKategorie kategorie, LogLevel level, const char* nachricht);
+
+/**
+ * Schreibt eine formatierte Log-Nachricht in einer bestimmten Kategorie
+ * @param kategorie Log-Kategorie
+ * @param level Log-Level
+ * @param format Printf-ähnliches Format
+ * @param ... Variable Argumente für Format
+ */
+void log_kategorie_formatiert(LogKategorie kategorie, LogLevel level, const char* format, ...);
+
+/**
+ * Setzt das aktuelle Log-Level für alle Kategorien
  * @param neues_level Neues Log-Level (0-3)
  */
 void log_level_setzen(int neues_level);
@@ -46,9 +124,50 @@ void log_level_setzen(int neues_level);
  */
 int log_level_abfragen(void);
 
+/**
+ * Setzt das Log-Level einer einzelnen Kategorie zur Laufzeit
+ * @param kategorie Log-Kategorie
+ * @param neues_level Neues Log-Level (0-3)
+ * @return 1 bei Erfolg, 0 bei ungültigen Parametern
+ */
+int log_kategorie_level_setzen(LogKategorie kategorie, int neues_level);
+
+/**
+ * Gibt das Log-Level einer Kategorie zurück
+ * @param kategorie Log-Kategorie
+ * @return Niedrigstes freigegebenes Level der Kategorie
+ */
+int log_kategorie_level_abfragen(LogKategorie kategorie);
+
+/**
+ * Wandelt einen Kategorie-Namen ("sensor", "display", ...) um
+ * @param name Name der Kategorie (Groß-/Kleinschreibung egal)
+ * @return Kategorie oder LOG_KAT_ANZAHL wenn unbekannt
+ */
+LogKategorie log_kategorie_aus_string(const char* name);
+
+/**
+ * Konvertiert eine Log-Kategorie zu String für Anzeige
+ * @param kategorie Log-Kategorie
+ * @return String-Darstellung der Kategorie
+ */
+const char* log_kategorie_zu_string(LogKategorie kategorie);
+
+/**
+ * Aktiviert die Aufzeichnung aller Level im Flugschreiber
+ * Die Ausgabe in Datei und Konsole folgt weiterhin den Log-Levels.
+ * @param aktiv 1 = alle Einträge aufzeichnen, 0 = Aufzeichnung aus
+ */
+void log_aufzeichnung_aktivieren(int aktiv);
+
+/**
+ * Erhöht das globale Log-Level zyklisch (DEBUG -> INFO -> WARNUNG -> FEHLER -> DEBUG)
+ */
+void log_level_weiterschalten(void);
+
 /**
  * Überprüft Taster-Eingabe und erhöht Log-Level bei Bedarf
- * Liest BUTTON_FILE und erhöht Log-Level stufenweise
+ * Optionaler Adapter: liest BUTTON_FILE und erhöht Log-Level stufenweise
  */
 void taster_pruefen_und_log_level_erhoehen(void);
 
@@ -59,22 +178,91 @@ void taster_pruefen_und_log_level_erhoehen(void);
  */
 const char* log_level_zu_string(LogLevel level);
 
+/**
+ * Periodische Wartung (einmal pro Durchlauf der Hauptschleife)
+ * Leert bzw. synchronisiert die Log-Datei gemäß Dauerhaftigkeits-Regel und
+ * gibt Zusammenfassungen beendeter oder lang anhaltender Wiederholungen aus
+ */
+void logging_zyklus(void);
+
+/**
+ * Zeit, bis logging_zyklus() die nächste zeitgesteuerte Synchronisation
+ * fällig hat (Stufe sync mit ungesicherten Einträgen)
+ * @param maximum Obergrenze in Millisekunden
+ * @return Wartezeit in Millisekunden (0 = sofort)
+ */
+int logging_wartezeit_ms(int maximum);
+
+/**
+ * Synchronisiert die Log-Datei aus einem Signal-Handler heraus
+ * Nur async-signal-sichere Aufrufe: Daten im stdio-Puffer gehen verloren,
+ * bereits an das Betriebssystem übergebene werden per fdatasync gesichert.
+ */
+void logging_notfall_sichern(void);
+
+/**
+ * Setzt die Dauerhaftigkeits-Regel der Log-Datei
+ * @param regel Neue Regel (Werte <= 0 für Intervall/Einträge: Standardwerte)
+ */
+void log_dauerhaftigkeit_setzen(const LogDauerhaftigkeit* regel);
+
+/**
+ * Liefert die aktuelle Dauerhaftigkeits-Regel
+ * @param regel Ziel-Struktur
+ */
+void log_dauerhaftigkeit_abfragen(LogDauerhaftigkeit* regel);
+
+/**
+ * Wandelt "keine", "batch" oder "sync[:MS[:N]]" in eine Regel um
+ * Das Feld fehler_sofort bleibt unverändert.
+ * @param text Angabe
+ * @param regel Ergebnis
+ * @return 1 bei Erfolg, 0 bei ungültiger Angabe
+ */
+int log_dauerhaftigkeit_aus_string(const char* text, LogDauerhaftigkeit* regel);
+
+/**
+ * Liefert den Namen einer Dauerhaftigkeits-Stufe
+ */
+const char* log_dauer_stufe_zu_string(LogDauerStufe stufe);
+
+/**
+ * Liefert die Zähler des Logging-Systems
+ * @param statistik Ziel-Struktur
+ */
+void log_statistik_abfragen(LogStatistik* statistik);
+
 /**
  * Beendet das Logging-System ordnungsgemäß
  * Schließt offene Dateien und gibt Ressourcen frei
  */
 void logging_beenden(void);
 
-// Makros für einfache Verwendung
-#define LOG_DEBUG_MSG(msg) log_nachricht(LOG_DEBUG, msg)
-#define LOG_INFO_MSG(msg) log_nachricht(LOG_INFO, msg)
-#define LOG_WARNING_MSG(msg) log_nachricht(LOG_WARNING, msg)
-#define LOG_ERROR_MSG(msg) log_nachricht(LOG_ERROR, msg)
+/**
+ * Schließt Log-Datei und Zeit-Index und öffnet sie neu (z.B. nach Rotation)
+ */
+void logging_neu_oeffnen(void);
+
+// Makros mit expliziter Kategorie; die Level-Prüfung erfolgt am Aufrufort,
+// gefilterte Nachrichten kosten weder Funktionsaufruf noch Formatierung
+#define LOG_K_MSG(kat, level, msg) \
+    do { if (LOG_AKTIV(kat, level)) log_kategorie_nachricht(kat, level, msg); } while (0)
+#define LOG_K_F(kat, level, ...) \
+    do { if (LOG_AKTIV(kat, level)) log_kategorie_formatiert(kat, level, __VA_ARGS__); } while (0)
+
+// Makros für einfache Verwendung (Kategorie des Moduls)
+#define LOG_DEBUG_MSG(msg) LOG_K_MSG(LOG_KATEGORIE, LOG_DEBUG, msg)
+#define LOG_INFO_MSG(msg) LOG_K_MSG(LOG_KATEGORIE, LOG_INFO, msg)
+#define LOG_WARNING_MSG(msg) LOG_K_MSG(LOG_KATEGORIE, LOG_WARNING, msg)
+#define LOG_ERROR_MSG(msg) LOG_K_MSG(LOG_KATEGORIE, LOG_ERROR, msg)
 
 // Formatierte Logging-Makros
-#define LOG_DEBUG_F(fmt, ...) log_formatiert(LOG_DEBUG, fmt, __VA_ARGS__)
-#define LOG_INFO_F(fmt, ...) log_formatiert(LOG_INFO, fmt, __VA_ARGS__)
-#define LOG_WARNING_F(fmt, ...) log_formatiert(LOG_WARNING, fmt, __VA_ARGS__)
-#define LOG_ERROR_F(fmt, ...) log_formatiert(LOG_ERROR, fmt, __VA_ARGS__)
+#define LOG_DEBUG_F(fmt, ...) LOG_K_F(LOG_KATEGORIE, LOG_DEBUG, fmt, __VA_ARGS__)
+#define LOG_INFO_F(fmt, ...) LOG_K_F(LOG_KATEGORIE, LOG_INFO, fmt, __VA_ARGS__)
+#define LOG_WARNING_F(fmt, ...) LOG_K_F(LOG_KATEGORIE, LOG_WARNING, fmt, __VA_ARGS__)
+#define LOG_ERROR_F(fmt, ...) LOG_K_F(LOG_KATEGORIE, LOG_ERROR, fmt, __VA_ARGS__)
+
+// Alarm-Meldungen laufen unabhängig vom Modul in der Kategorie ALARM
+#define LOG_ALARM_F(fmt, ...) LOG_K_F(LOG_KAT_ALARM, LOG_WARNING, fmt, __VA_ARGS__)
 
 #endif // LOGGING_H
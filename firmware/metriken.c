@@ -0,0 +1,236 @@
+#include "metriken.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+// Eintrag im Register
+typedef struct {
+    const char* name;
+    const char* labels;
+    const char* hilfe;
+    MetrikTyp typ;
+    const unsigned long* zaehler;
+    MetrikLesen lesen;
+    const LatenzHistogramm* histogramm;
+} Metrik;
+
+// Obergrenzen der exportierten Histogramm-Fächer in Mikrosekunden
+// (die internen log-linearen Fächer werden darauf zusammengefasst)
+static const uint64_t HISTOGRAMM_GRENZEN_US[] = {
+    100, 500, 1000, 5000, 10000, 50000, 100000, 500000, 1000000, 5000000
+};
+#define HISTOGRAMM_GRENZEN (sizeof(HISTOGRAMM_GRENZEN_US) / sizeof(HISTOGRAMM_GRENZEN_US[0]))
+
+static Metrik metriken[METRIKEN_MAX];
+static int anzahl = 0;
+static char export_puffer[32768];
+
+static int metrik_anlegen(const char* name, const char* labels, const char* hilfe, MetrikTyp typ, Metrik** ziel);
+static int kopf_bereits_ausgegeben(int index);
+static size_t anhaengen(char* puffer, size_t groesse, size_t pos, const char* format, ...);
+static size_t metrik_ausgeben(char* puffer, size_t groesse, size_t pos, const Metrik* m);
+
+/**
+ * Registriert einen Zähler
+ */
+int metrik_zaehler_registrieren(const char* name, const char* labels, const char* hilfe,
+                                const unsigned long* wert) {
+    Metrik* m;
+    if (!metrik_anlegen(name, labels, hilfe, METRIK_ZAEHLER, &m)) {
+        return 0;
+    }
+    m->zaehler = wert;
+    return 1;
+}
+
+/**
+ * Registriert einen Momentanwert
+ */
+int metrik_messwert_registrieren(const char* name, const char* labels, const char* hilfe,
+                                 MetrikLesen lesen) {
+    Metrik* m;
+    if (!metrik_anlegen(name, labels, hilfe, METRIK_MESSWERT, &m)) {
+        return 0;
+    }
+    m->lesen = lesen;
+    return 1;
+}
+
+/**
+ * Registriert ein Latenz-Histogramm
+ */
+int metrik_histogramm_registrieren(const char* name, const char* labels, const char* hilfe,
+                                   const LatenzHistogramm* histogramm) {
+    Metrik* m;
+    if (!metrik_anlegen(name, labels, hilfe, METRIK_HISTOGRAMM, &m)) {
+        return 0;
+    }
+    m->histogramm = histogramm;
+    return 1;
+}
+
+/**
+ * Formatiert alle Metriken im Prometheus-Textformat
+ * Metriken gleichen Namens stehen unter einem gemeinsamen HELP/TYPE-Kopf.
+ * Passt eine Familie nicht mehr, wird sie samt allen folgenden weggelassen.
+ */
+size_t metriken_exportieren(char* puffer, size_t groesse, int* gekuerzt) {
+    static const char* const TYP_NAMEN[] = {"counter", "gauge", "histogram"};
+    size_t pos = 0;
+
+    if (gekuerzt != NULL) {
+        *gekuerzt = 0;
+    }
+    if (groesse == 0) {
+        if (gekuerzt != NULL) {
+            *gekuerzt = anzahl > 0;
+        }
+        return 0;
+    }
+    puffer[0] = '\0';
+
+    for (int i = 0; i < anzahl; i++) {
+        if (kopf_bereits_ausgegeben(i)) {
+            continue;
+        }
+        size_t familie_start = pos;
+        pos = anhaengen(puffer, groesse, pos, "# HELP " METRIKEN_PRAEFIX "%s %s\n",
+                        metriken[i].name, metriken[i].hilfe != NULL ? metriken[i].hilfe : "");
+        pos = anhaengen(puffer, groesse, pos, "# TYPE " METRIKEN_PRAEFIX "%s %s\n",
+                        metriken[i].name, TYP_NAMEN[metriken[i].typ]);
+        for (int j = i; j < anzahl; j++) {
+            if (strcmp(metriken[j].name, metriken[i].name) == 0) {
+                pos = metrik_ausgeben(puffer, groesse, pos, &metriken[j]);
+            }
+        }
+        if (pos >= groesse) {
+            // Familie passt nicht mehr: auf die letzte vollständige zurücksetzen
+            puffer[familie_start] = '\0';
+            if (gekuerzt != NULL) {
+                *gekuerzt = 1;
+            }
+            return familie_start;
+        }
+    }
+    return pos;
+}
+
+/**
+ * Schreibt alle Metriken atomar in eine Datei
+ * Leser sehen immer entweder den alten oder den neuen vollständigen Stand.
+ */
+int metriken_datei_schreiben(const char* pfad) {
+    char temp_pfad[256];
+    if (snprintf(temp_pfad, sizeof(temp_pfad), "%s.tmp", pfad) >= (int)sizeof(temp_pfad)) {
+        return 0;
+    }
+
+    int gekuerzt;
+    size_t laenge = metriken_exportieren(export_puffer, sizeof(export_puffer), &gekuerzt);
+    FILE* datei = fopen(temp_pfad, "w");
+    if (datei == NULL) {
+        return 0;
+    }
+    int erfolg = fwrite(export_puffer, 1, laenge, datei) == laenge;
+    erfolg = (fclose(datei) == 0) && erfolg;
+
+    if (!erfolg || rename(temp_pfad, pfad) != 0) {
+        remove(temp_pfad);
+        return 0;
+    }
+    return gekuerzt ? -1 : 1;
+}
+
+/**
+ * Anzahl registrierter Metriken
+ */
+int metriken_anzahl(void) {
+    return anzahl;
+}
+
+/**
+ * Legt einen Eintrag im Register an
+ */
+static int metrik_anlegen(const char* name, const char* labels, const char* hilfe, MetrikTyp typ, Metrik** ziel) {
+    if (anzahl >= METRIKEN_MAX) {
+        return 0;
+    }
+    Metrik* m = &metriken[anzahl++];
+    memset(m, 0, sizeof(*m));
+    m->name = name;
+    m->labels = (labels != NULL && labels[0] != '\0') ? labels : NULL;
+    m->hilfe = hilfe;
+    m->typ = typ;
+    *ziel = m;
+    return 1;
+}
+
+/**
+ * Prüft, ob eine frühere Metrik gleichen Namens den Kopf schon ausgegeben hat
+ */
+static int kopf_bereits_ausgegeben(int index) {
+    for (int i = 0; i < index; i++) {
+        if (strcmp(metriken[i].name, metriken[index].name) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Hängt formatierten Text an
+ * @return Neue Position; groesse, wenn der Text nicht vollständig passt
+ *         (weitere Aufrufe hängen dann nichts mehr an)
+ */
+static size_t anhaengen(char* puffer, size_t groesse, size_t pos, const char* format, ...) {
+    if (pos + 1 >= groesse) {
+        return groesse;
+    }
+
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(puffer + pos, groesse - pos, format, args);
+    va_end(args);
+
+    if (n < 0) {
+        return pos;
+    }
+    pos += (size_t)n;
+    return pos < groesse ? pos : groesse;
+}
+
+/**
+ * Gibt die Zeilen einer Metrik aus
+ */
+static size_t metrik_ausgeben(char* puffer, size_t groesse, size_t pos, const Metrik* m) {
+    const char* labels = m->labels != NULL ? m->labels : "";
+    const char* klammer_auf = m->labels != NULL ? "{" : "";
+    const char* klammer_zu = m->labels != NULL ? "}" : "";
+
+    switch (m->typ) {
+        case METRIK_ZAEHLER:
+            return anhaengen(puffer, groesse, pos, METRIKEN_PRAEFIX "%s%s%s%s %lu\n",
+                             m->name, klammer_auf, labels, klammer_zu, *m->zaehler);
+
+        case METRIK_MESSWERT:
+            return anhaengen(puffer, groesse, pos, METRIKEN_PRAEFIX "%s%s%s%s %.6g\n",
+                             m->name, klammer_auf, labels, klammer_zu, m->lesen());
+
+        case METRIK_HISTOGRAMM: {
+            const LatenzHistogramm* h = m->histogramm;
+            const char* trenner = m->labels != NULL ? "," : "";
+            for (size_t i = 0; i < HISTOGRAMM_GRENZEN; i++) {
+                pos = anhaengen(puffer, groesse, pos, METRIKEN_PRAEFIX "%s_bucket{%s%sle=\"%g\"} %lu\n",
+                                m->name, labels, trenner, (double)HISTOGRAMM_GRENZEN_US[i] / 1e6,
+                                latenz_anzahl_bis(h, HISTOGRAMM_GRENZEN_US[i]));
+            }
+            pos = anhaengen(puffer, groesse, pos, METRIKEN_PRAEFIX "%s_bucket{%s%sle=\"+Inf\"} %lu\n",
+                            m->name, labels, trenner, h->anzahl);
+            pos = anhaengen(puffer, groesse, pos, METRIKEN_PRAEFIX "%s_sum%s%s%s %.6f\n",
+                            m->name, klammer_auf, labels, klammer_zu, (double)h->summe_us / 1e6);
+            return anhaengen(puffer, groesse, pos, METRIKEN_PRAEFIX "%s_count%s%s%s %lu\n",
+                             m->name, klammer_auf, labels, klammer_zu, h->anzahl);
+        }
+    }
+    return pos;
+}
@@ -0,0 +1,88 @@
+#ifndef METRIKEN_H
+#define METRIKEN_H
+
+#include <stddef.h>
+#include "latenz.h"
+
+// Metrik-Register für externe Überwachung (Prometheus-Textformat)
+// Die Module registrieren beim Initialisieren Verweise auf ihre eigenen
+// Zähler, Histogramme und Lesefunktionen für Momentanwerte. Gezählt wird
+// weiter in den Modulen selbst (ohne Sperren, die Firmware ist einfädig);
+// erst beim Export werden die Werte eingesammelt und formatiert.
+
+// Art einer Metrik
+typedef enum {
+    METRIK_ZAEHLER = 0,             // Monoton steigend (counter)
+    METRIK_MESSWERT,                // Momentanwert (gauge)
+    METRIK_HISTOGRAMM               // Verteilung in Sekunden (histogram)
+} MetrikTyp;
+
+// Liefert einen Momentanwert
+typedef double (*MetrikLesen)(void);
+
+// Größe des Registers und Präfix aller Namen
+#define METRIKEN_MAX 96
+#define METRIKEN_PRAEFIX "kuehlschrank_"
+
+// Funktionsdeklarationen
+
+/**
+ * Registriert einen Zähler
+ * @param name Name ohne Präfix (z.B. "sensor_lesevorgaenge_total")
+ * @param labels Labels ohne Klammern (z.B. "sensor=\"temperatur\"") oder NULL
+ * @param hilfe Beschreibung (gilt für alle Metriken gleichen Namens; bei
+ *              weiteren Labels desselben Namens genügt NULL)
+ * @param wert Zähler des Moduls (muss gültig bleiben)
+ * @return 1 bei Erfolg, 0 wenn das Register voll ist
+ */
+int metrik_zaehler_registrieren(const char* name, const char* labels, const char* hilfe,
+                                const unsigned long* wert);
+
+/**
+ * Registriert einen Momentanwert
+ * @param name Name ohne Präfix
+ * @param labels Labels oder NULL
+ * @param hilfe Beschreibung
+ * @param lesen Wird bei jedem Export aufgerufen
+ * @return 1 bei Erfolg, 0 wenn das Register voll ist
+ */
+int metrik_messwert_registrieren(const char* name, const char* labels, const char* hilfe,
+                                 MetrikLesen lesen);
+
+/**
+ * Registriert ein Latenz-Histogramm (Export in Sekunden)
+ * @param name Name ohne Präfix (z.B. "schleife_arbeit_sekunden")
+ * @param labels Labels oder NULL
+ * @param hilfe Beschreibung
+ * @param histogramm Histogramm des Moduls (muss gültig bleiben)
+ * @return 1 bei Erfolg, 0 wenn das Register voll ist
+ */
+int metrik_histogramm_registrieren(const char* name, const char* labels, const char* hilfe,
+                                   const LatenzHistogramm* histogramm);
+
+/**
+ * Formatiert alle Metriken im Prometheus-Textformat (Version 0.0.4)
+ * Bei zu kleinem Puffer endet der Text nach der letzten vollständigen
+ * Metrik-Familie (HELP/TYPE-Kopf mit allen Zeilen), nie mitten in einer Zeile.
+ * @param puffer Ziel
+ * @param groesse Größe des Ziels
+ * @param gekuerzt Ziel für 1 wenn Familien fehlen, sonst 0 (oder NULL)
+ * @return Länge des Textes
+ */
+size_t metriken_exportieren(char* puffer, size_t groesse, int* gekuerzt);
+
+/**
+ * Schreibt alle Metriken atomar in eine Datei (temporäre Datei + rename)
+ * @param pfad Ziel-Datei (z.B. für den Textfile-Collector)
+ * @return 1 bei Erfolg, -1 wenn gekürzt (nur vollständige Familien
+ *         geschrieben), 0 bei Fehler
+ */
+int metriken_datei_schreiben(const char* pfad);
+
+/**
+ * Anzahl registrierter Metriken
+ * @return Anzahl
+ */
+int metriken_anzahl(void);
+
+#endif // METRIKEN_H
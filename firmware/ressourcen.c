@@ -0,0 +1,265 @@
+// Für getrusage/opendir/clock_gettime unter C99
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+
+#include "ressourcen.h"
+#include "logging.h"
+#include "metriken.h"
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+static RessourcenProbe verlauf[RESSOURCEN_VERLAUF];
+static int verlauf_anzahl = 0;
+static int verlauf_ende = 0;            // Nächste Schreibposition
+
+// Gemeldete Befunde (erneute Warnung erst nach Entwarnung)
+static int rss_leck_gemeldet = 0;
+static int daten_leck_gemeldet = 0;
+static int fd_leck_gemeldet = 0;
+static int cpu_anstieg_gemeldet = 0;
+
+static long long monotone_ms(void);
+static const RessourcenProbe* probe_an(int index);
+static int stetiger_anstieg(size_t feld_offset, unsigned long mindest_zuwachs, unsigned long* zuwachs);
+static double cpu_mittel(int von, int bis);
+static void befund_melden(int befund, int* gemeldet, const char* name, const char* text);
+static double rss_metrik(void);
+static double daten_metrik(void);
+static double fds_metrik(void);
+static double cpu_sekunden_metrik(void);
+static double cpu_prozent_metrik(void);
+
+/**
+ * Setzt den Verlauf zurück und meldet die Metriken an
+ */
+void ressourcen_initialisieren(void) {
+    verlauf_anzahl = 0;
+    verlauf_ende = 0;
+
+    metrik_messwert_registrieren("prozess_rss_kib", NULL, "Resident Set Size der Firmware", rss_metrik);
+    metrik_messwert_registrieren("prozess_daten_kib", NULL, "Daten-Segment inklusive Heap (VmData)",
+                                 daten_metrik);
+    metrik_messwert_registrieren("prozess_offene_fds", NULL, "Offene Dateideskriptoren", fds_metrik);
+    metrik_messwert_registrieren("prozess_cpu_sekunden", NULL, "Verbrauchte CPU-Zeit (Benutzer + System)",
+                                 cpu_sekunden_metrik);
+    metrik_messwert_registrieren("prozess_cpu_prozent", NULL, "CPU-Last seit der vorherigen Status-Prüfung",
+                                 cpu_prozent_metrik);
+}
+
+/**
+ * Liest die aktuellen Werte des Prozesses
+ */
+void ressourcen_abtasten(RessourcenProbe* probe) {
+    memset(probe, 0, sizeof(*probe));
+    probe->zeit_ms = monotone_ms();
+
+    struct rusage nutzung;
+    if (getrusage(RUSAGE_SELF, &nutzung) == 0) {
+        probe->cpu_us = (unsigned long long)nutzung.ru_utime.tv_sec * 1000000ULL + (unsigned long long)nutzung.ru_utime.tv_usec +
+                        (unsigned long long)nutzung.ru_stime.tv_sec * 1000000ULL + (unsigned long long)nutzung.ru_stime.tv_usec;
+        probe->freiwillige_wechsel = (unsigned long)nutzung.ru_nvcsw;
+        probe->unfreiwillige_wechsel = (unsigned long)nutzung.ru_nivcsw;
+    }
+
+    // statm: Größe, resident, shared, text, lib, data, dt (in Seiten)
+    FILE* datei = fopen("/proc/self/statm", "r");
+    if (datei != NULL) {
+        unsigned long groesse, resident, geteilt, text, bibliothek, daten;
+        if (fscanf(datei, "%lu %lu %lu %lu %lu %lu", &groesse, &resident, &geteilt, &text, &bibliothek, &daten) == 6) {
+            unsigned long seite_kib = (unsigned long)sysconf(_SC_PAGESIZE) / 1024;
+            probe->rss_kib = resident * seite_kib;
+            probe->daten_kib = daten * seite_kib;
+        }
+        fclose(datei);
+    }
+
+    // io: rchar/wchar zählen alle read/write-Bytes (auch Page-Cache)
+    datei = fopen("/proc/self/io", "r");
+    if (datei != NULL) {
+        char zeile[64];
+        while (fgets(zeile, sizeof(zeile), datei) != NULL) {
+            sscanf(zeile, "rchar: %llu", &probe->gelesen_bytes);
+            sscanf(zeile, "wchar: %llu", &probe->geschrieben_bytes);
+        }
+        fclose(datei);
+    }
+
+    DIR* verzeichnis = opendir("/proc/self/fd");
+    if (verzeichnis != NULL) {
+        struct dirent* eintrag;
+        while ((eintrag = readdir(verzeichnis)) != NULL) {
+            if (eintrag->d_name[0] != '.') {
+                probe->offene_fds++;
+            }
+        }
+        closedir(verzeichnis);
+        if (probe->offene_fds > 0) {
+            probe->offene_fds--; // Deskriptor des Verzeichnisses selbst
+        }
+    }
+}
+
+/**
+ * Nimmt eine Probe auf und prüft die Trends
+ */
+void ressourcen_pruefen(void) {
+    RessourcenProbe* probe = &verlauf[verlauf_ende];
+    ressourcen_abtasten(probe);
+
+    if (verlauf_anzahl > 0) {
+        const RessourcenProbe* vorher = probe_an(verlauf_anzahl - 1);
+        long long dauer_ms = probe->zeit_ms - vorher->zeit_ms;
+        if (dauer_ms > 0 && probe->cpu_us >= vorher->cpu_us) {
+            probe->cpu_prozent = (double)(probe->cpu_us - vorher->cpu_us) / (double)dauer_ms / 10.0;
+        }
+    }
+    verlauf_ende = (verlauf_ende + 1) % RESSOURCEN_VERLAUF;
+    if (verlauf_anzahl < RESSOURCEN_VERLAUF) {
+        verlauf_anzahl++;
+    }
+
+    LOG_DEBUG_F("Ressourcen: RSS %lu KiB, Daten %lu KiB, %lu FDs, CPU %.1f %%, Wechsel %lu/%lu",
+                probe->rss_kib, probe->daten_kib, probe->offene_fds, probe->cpu_prozent,
+                probe->freiwillige_wechsel, probe->unfreiwillige_wechsel);
+
+    if (verlauf_anzahl < RESSOURCEN_MIN_PROBEN) {
+        return;
+    }
+
+    char text[160];
+    unsigned long zuwachs;
+    int befund;
+
+    befund = stetiger_anstieg(offsetof(RessourcenProbe, rss_kib), RESSOURCEN_LECK_KIB, &zuwachs);
+    snprintf(text, sizeof(text), "Mögliches Speicherleck: RSS stetig um %lu KiB auf %lu KiB gestiegen",
+             zuwachs, probe->rss_kib);
+    befund_melden(befund, &rss_leck_gemeldet, "RSS", text);
+
+    befund = stetiger_anstieg(offsetof(RessourcenProbe, daten_kib), RESSOURCEN_LECK_KIB, &zuwachs);
+    snprintf(text, sizeof(text), "Mögliches Heap-Leck: Daten-Segment stetig um %lu KiB auf %lu KiB gestiegen",
+             zuwachs, probe->daten_kib);
+    befund_melden(befund, &daten_leck_gemeldet, "Daten-Segment", text);
+
+    befund = stetiger_anstieg(offsetof(RessourcenProbe, offene_fds), RESSOURCEN_FD_ZUWACHS, &zuwachs);
+    snprintf(text, sizeof(text), "Mögliches Deskriptor-Leck: %lu zusätzliche Dateideskriptoren (jetzt %lu)",
+             zuwachs, probe->offene_fds);
+    befund_melden(befund, &fd_leck_gemeldet, "Dateideskriptoren", text);
+
+    // CPU: letzte vier Proben gegenüber der ersten Hälfte des Fensters
+    // (die erste Probe hat keine Vorgängerin und zählt nicht mit)
+    double aktuell = cpu_mittel(verlauf_anzahl - 4, verlauf_anzahl);
+    double referenz = cpu_mittel(1, verlauf_anzahl / 2);
+    befund = aktuell > referenz * RESSOURCEN_CPU_FAKTOR && aktuell - referenz > RESSOURCEN_CPU_MIN_PROZENT;
+    snprintf(text, sizeof(text), "CPU-Last gestiegen: %.1f %% gegenüber %.1f %% zu Beginn des Fensters",
+             aktuell, referenz);
+    befund_melden(befund, &cpu_anstieg_gemeldet, "CPU-Last", text);
+}
+
+/**
+ * Kopiert den Verlauf
+ */
+int ressourcen_verlauf(RessourcenProbe* ziel, int max_anzahl) {
+    int anzahl = verlauf_anzahl < max_anzahl ? verlauf_anzahl : max_anzahl;
+    int erste = verlauf_anzahl - anzahl;
+    for (int i = 0; i < anzahl; i++) {
+        ziel[i] = *probe_an(erste + i);
+    }
+    return anzahl;
+}
+
+/**
+ * Monotone Zeit in Millisekunden
+ */
+static long long monotone_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/**
+ * Probe nach Alter (0 = älteste im Verlauf)
+ */
+static const RessourcenProbe* probe_an(int index) {
+    int anfang = (verlauf_ende - verlauf_anzahl + RESSOURCEN_VERLAUF) % RESSOURCEN_VERLAUF;
+    return &verlauf[(anfang + index) % RESSOURCEN_VERLAUF];
+}
+
+/**
+ * Stetiger Anstieg eines Felds über das Fenster
+ * Jeder Wert der zweiten Hälfte liegt mindestens beim Höchstwert der ersten
+ * Hälfte, und der Zuwachs vom Minimum der ersten Hälfte bis zum letzten Wert
+ * übersteigt die Schwelle. Einmalige Sprünge beim Start (Puffer anlegen)
+ * und schwankende Werte lösen so keine Warnung aus.
+ */
+static int stetiger_anstieg(size_t feld_offset, unsigned long mindest_zuwachs, unsigned long* zuwachs) {
+    int mitte = verlauf_anzahl / 2;
+    unsigned long erste_min = (unsigned long)-1, erste_max = 0, zweite_min = (unsigned long)-1;
+
+    for (int i = 0; i < verlauf_anzahl; i++) {
+        unsigned long wert = *(const unsigned long*)((const char*)probe_an(i) + feld_offset);
+        if (i < mitte) {
+            erste_min = wert < erste_min ? wert : erste_min;
+            erste_max = wert > erste_max ? wert : erste_max;
+        } else {
+            zweite_min = wert < zweite_min ? wert : zweite_min;
+        }
+    }
+
+    unsigned long letzter = *(const unsigned long*)((const char*)probe_an(verlauf_anzahl - 1) + feld_offset);
+    *zuwachs = letzter > erste_min ? letzter - erste_min : 0;
+    return zweite_min >= erste_max && letzter > erste_max && *zuwachs >= mindest_zuwachs;
+}
+
+/**
+ * Mittlere CPU-Last der Proben [von, bis)
+ */
+static double cpu_mittel(int von, int bis) {
+    double summe = 0.0;
+    int anzahl = 0;
+    for (int i = von < 0 ? 0 : von; i < bis; i++) {
+        summe += probe_an(i)->cpu_prozent;
+        anzahl++;
+    }
+    return anzahl > 0 ? summe / anzahl : 0.0;
+}
+
+/**
+ * Meldet einen Befund einmal und die Entwarnung, sobald er verschwindet
+ */
+static void befund_melden(int befund, int* gemeldet, const char* name, const char* text) {
+    if (befund && !*gemeldet) {
+        LOG_WARNING_F("%s", text);
+        *gemeldet = 1;
+    } else if (!befund && *gemeldet) {
+        LOG_INFO_F("%s wieder unauffällig", name);
+        *gemeldet = 0;
+    }
+}
+
+/**
+ * Momentanwerte der jüngsten Probe für das Metrik-Register
+ */
+static double rss_metrik(void) {
+    return verlauf_anzahl > 0 ? (double)probe_an(verlauf_anzahl - 1)->rss_kib : 0.0;
+}
+
+static double daten_metrik(void) {
+    return verlauf_anzahl > 0 ? (double)probe_an(verlauf_anzahl - 1)->daten_kib : 0.0;
+}
+
+static double fds_metrik(void) {
+    return verlauf_anzahl > 0 ? (double)probe_an(verlauf_anzahl - 1)->offene_fds : 0.0;
+}
+
+static double cpu_sekunden_metrik(void) {
+    return verlauf_anzahl > 0 ? (double)probe_an(verlauf_anzahl - 1)->cpu_us / 1e6 : 0.0;
+}
+
+static double cpu_prozent_metrik(void) {
+    return verlauf_anzahl > 0 ? probe_an(verlauf_anzahl - 1)->cpu_prozent : 0.0;
+}
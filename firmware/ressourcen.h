@@ -0,0 +1,63 @@
+#ifndef RESSOURCEN_H
+#define RESSOURCEN_H
+
+#include "config.h"
+
+// Ressourcen-Überwachung des eigenen Prozesses
+// Bei jeder Status-Prüfung wird eine Probe aus getrusage() und /proc/self
+// genommen und in einem Ringpuffer fester Größe abgelegt. Über das Fenster
+// des Puffers werden Speicher- und Deskriptor-Lecks (stetiger Anstieg) sowie
+// ein Anstieg der CPU-Last gegenüber dem Beginn des Fensters erkannt.
+
+// Eine Probe
+typedef struct {
+    long long zeit_ms;                      // CLOCK_MONOTONIC
+    unsigned long rss_kib;                  // Resident Set Size
+    unsigned long daten_kib;                // Daten-Segment inkl. Heap (VmData)
+    unsigned long offene_fds;
+    unsigned long long cpu_us;              // Benutzer- und Systemzeit
+    unsigned long freiwillige_wechsel;      // Kontextwechsel (warten, z.B. poll)
+    unsigned long unfreiwillige_wechsel;    // Kontextwechsel (verdrängt)
+    unsigned long long gelesen_bytes;       // rchar aus /proc/self/io
+    unsigned long long geschrieben_bytes;   // wchar aus /proc/self/io
+    double cpu_prozent;                     // Seit der vorherigen Probe
+} RessourcenProbe;
+
+// Größe des Verlaufs und Schwellen der Trend-Erkennung
+#define RESSOURCEN_VERLAUF 64               // Proben (bei 30 s: 32 Minuten)
+#define RESSOURCEN_MIN_PROBEN 16            // Mindestfenster für Trend-Warnungen
+#define RESSOURCEN_LECK_KIB 512             // Mindestzuwachs für eine Leck-Warnung
+#define RESSOURCEN_FD_ZUWACHS 4             // Zusätzliche Deskriptoren für eine Leck-Warnung
+#define RESSOURCEN_CPU_FAKTOR 2.0           // Aktuelle CPU-Last gegenüber Fensterbeginn
+#define RESSOURCEN_CPU_MIN_PROZENT 2.0      // Kleinere Anstiege werden nicht gemeldet
+
+// Funktionsdeklarationen
+
+/**
+ * Setzt den Verlauf zurück und meldet die Werte beim Metrik-Register an
+ * Die erste Probe nimmt die erste Status-Prüfung.
+ */
+void ressourcen_initialisieren(void);
+
+/**
+ * Liest die aktuellen Werte des Prozesses
+ * Nicht verfügbare Quellen (z.B. /proc/self/io) ergeben 0.
+ * @param probe Ziel (cpu_prozent bleibt 0)
+ */
+void ressourcen_abtasten(RessourcenProbe* probe);
+
+/**
+ * Nimmt eine Probe in den Verlauf auf und prüft die Trends
+ * Warnungen werden je Befund einmal geloggt, bis er wieder verschwindet.
+ */
+void ressourcen_pruefen(void);
+
+/**
+ * Kopiert den Verlauf (älteste Probe zuerst)
+ * @param ziel Zielfeld
+ * @param max_anzahl Größe des Zielfelds
+ * @return Anzahl kopierter Proben
+ */
+int ressourcen_verlauf(RessourcenProbe* ziel, int max_anzahl);
+
+#endif // RESSOURCEN_H
@@ -1,5 +1,8 @@
+#define LOG_KATEGORIE LOG_KAT_SENSOR
+
 #include "sensor.h"
 #include "logging.h"
+#include "metriken.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -12,14 +15,21 @@ SensorDaten aktuelle_sensordaten = {0};
 DateiInfo datei_infos[4] = {0};
 
 // Statische Variablen für Simulation
-static time_t letzter_schreibvorgang = 0;
 static float basis_temperatur = 4.0f;  // Basis für Temperaturschwankungen
 
+static SensorStatistik statistik = {0};
+
+static void metriken_registrieren(void);
+static double temperatur_metrik(void);
+static double tuer_metrik(void);
+static double energie_metrik(void);
+
 /**
  * Initialisiert das Sensor-System
  */
 void sensor_system_initialisieren(void) {
     LOG_INFO_MSG("Sensor-System wird initialisiert...");
+    metriken_registrieren();
     
     // Standard-Sensor-Dateien erstellen falls nicht vorhanden
     standard_sensor_dateien_erstellen();
@@ -34,8 +44,6 @@ void sensor_system_initialisieren(void) {
     } else {
         LOG_ERROR_MSG("Fehler beim Initialisieren des Sensor-Systems");
     }
-    
-    letzter_schreibvorgang = time(NULL);
 }
 
 /**
@@ -48,10 +56,12 @@ int sensor_werte_lesen(SensorDaten* daten) {
     }
     
     int erfolg = 1;
+    statistik.lesevorgaenge++;
     
     // Temperatur lesen
     if (!temperatur_lesen(&daten->temperatur)) {
         LOG_WARNING_MSG("Fehler beim Lesen der Temperatur");
+        statistik.lesefehler_temperatur++;
         daten->temperatur = TARGET_TEMPERATURE; // Fallback-Wert
         erfolg = 0;
     }
@@ -59,6 +69,7 @@ int sensor_werte_lesen(SensorDaten* daten) {
     // Tür-Status lesen
     if (!tuer_status_lesen(&daten->tuer_offen, &daten->tuer_offen_seit)) {
         LOG_WARNING_MSG("Fehler beim Lesen des Tür-Status");
+        statistik.lesefehler_tuer++;
         daten->tuer_offen = 0; // Fallback: Tür geschlossen
         daten->tuer_offen_seit = 0;
         erfolg = 0;
@@ -67,6 +78,7 @@ int sensor_werte_lesen(SensorDaten* daten) {
     // Energieverbrauch lesen
     if (!energie_lesen(&daten->energie_verbrauch)) {
         LOG_WARNING_MSG("Fehler beim Lesen des Energieverbrauchs");
+        statistik.lesefehler_energie++;
         daten->energie_verbrauch = TARGET_ENERGY; // Fallback-Wert
         erfolg = 0;
     }
@@ -74,6 +86,7 @@ int sensor_werte_lesen(SensorDaten* daten) {
     // Daten validieren
     if (!sensor_werte_validieren(daten)) {
         LOG_WARNING_MSG("Sensor-Werte sind nicht plausibel");
+        statistik.unplausibel++;
         erfolg = 0;
     }
     
@@ -82,16 +95,9 @@ int sensor_werte_lesen(SensorDaten* daten) {
 }
 
 /**
- * Schreibt simulierte Sensor-Werte (alle 5 Sekunden)
+ * Schreibt simulierte Sensor-Werte (Takt vom Zeitplaner)
  */
 void sensor_werte_simulieren_und_schreiben(void) {
-    time_t jetzt = time(NULL);
-    
-    // Prüfen ob 5 Sekunden vergangen sind
-    if (jetzt - letzter_schreibvorgang < SENSOR_WRITE_INTERVAL) {
-        return;
-    }
-    
     LOG_DEBUG_MSG("Generiere neue Sensor-Werte...");
     
     SensorDaten neue_daten;
@@ -121,8 +127,6 @@ void sensor_werte_simulieren_und_schreiben(void) {
         fclose(energie_datei);
         LOG_DEBUG_F("Neuer Energieverbrauch geschrieben: %.2fW", neue_daten.energie_verbrauch);
     }
-    
-    letzter_schreibvorgang = jetzt;
 }
 
 /**
@@ -306,15 +310,17 @@ int sensor_alarme_pruefen(const SensorDaten* daten) {
     
     // Temperatur zu hoch
     if (daten->temperatur > MAX_TEMP_THRESHOLD) {
-        LOG_WARNING_F("ALARM: Temperatur zu hoch! %.2f°C (Max: %.2f°C)", 
+        LOG_ALARM_F("ALARM: Temperatur zu hoch! %.2f°C (Max: %.2f°C)", 
                      daten->temperatur, MAX_TEMP_THRESHOLD);
+        statistik.alarme_temperatur_hoch++;
         probleme++;
     }
     
     // Temperatur zu niedrig
     if (daten->temperatur < MIN_TEMP_THRESHOLD) {
-        LOG_WARNING_F("ALARM: Temperatur zu niedrig! %.2f°C (Min: %.2f°C)", 
+        LOG_ALARM_F("ALARM: Temperatur zu niedrig! %.2f°C (Min: %.2f°C)", 
                      daten->temperatur, MIN_TEMP_THRESHOLD);
+        statistik.alarme_temperatur_niedrig++;
         probleme++;
     }
     
@@ -322,16 +328,18 @@ int sensor_alarme_pruefen(const SensorDaten* daten) {
     if (daten->tuer_offen) {
         long offen_dauer = tuer_offen_dauer_berechnen(daten->tuer_offen_seit);
         if (offen_dauer > DOOR_OPEN_THRESHOLD) {
-            LOG_WARNING_F("ALARM: Tür zu lange offen! %ld Sekunden (Max: %d)", 
+            LOG_ALARM_F("ALARM: Tür zu lange offen! %ld Sekunden (Max: %d)", 
                          offen_dauer, DOOR_OPEN_THRESHOLD);
+            statistik.alarme_tuer++;
             probleme++;
         }
     }
     
     // Energieverbrauch zu hoch
     if (daten->energie_verbrauch > MAX_ENERGY_THRESHOLD) {
-        LOG_WARNING_F("ALARM: Energieverbrauch zu hoch! %.2fW (Max: %.2fW)", 
+        LOG_ALARM_F("ALARM: Energieverbrauch zu hoch! %.2fW (Max: %.2fW)", 
                      daten->energie_verbrauch, MAX_ENERGY_THRESHOLD);
+        statistik.alarme_energie++;
         probleme++;
     }
     
@@ -348,6 +356,52 @@ long tuer_offen_dauer_berechnen(long offen_seit) {
     return time(NULL) - offen_seit;
 }
 
+/**
+ * Liefert die Zähler des Sensor-Systems
+ */
+void sensor_statistik_abfragen(SensorStatistik* ziel) {
+    *ziel = statistik;
+}
+
+/**
+ * Meldet Zähler und aktuelle Messwerte beim Metrik-Register an
+ */
+static void metriken_registrieren(void) {
+    metrik_zaehler_registrieren("sensor_lesevorgaenge_total", NULL,
+                                "Lesevorgänge aller Sensor-Dateien", &statistik.lesevorgaenge);
+    metrik_zaehler_registrieren("sensor_lesefehler_total", "sensor=\"temperatur\"",
+                                "Sensor-Dateien, die fehlten oder nicht geparst werden konnten",
+                                &statistik.lesefehler_temperatur);
+    metrik_zaehler_registrieren("sensor_lesefehler_total", "sensor=\"tuer\"", NULL, &statistik.lesefehler_tuer);
+    metrik_zaehler_registrieren("sensor_lesefehler_total", "sensor=\"energie\"", NULL, &statistik.lesefehler_energie);
+    metrik_zaehler_registrieren("sensor_unplausibel_total", NULL,
+                                "Gelesene Werte außerhalb der Plausibilitätsgrenzen", &statistik.unplausibel);
+    metrik_zaehler_registrieren("sensor_alarme_total", "alarm=\"temperatur_hoch\"",
+                                "Alarm-Prüfungen mit ausgelöstem Alarm", &statistik.alarme_temperatur_hoch);
+    metrik_zaehler_registrieren("sensor_alarme_total", "alarm=\"temperatur_niedrig\"", NULL,
+                                &statistik.alarme_temperatur_niedrig);
+    metrik_zaehler_registrieren("sensor_alarme_total", "alarm=\"tuer\"", NULL, &statistik.alarme_tuer);
+    metrik_zaehler_registrieren("sensor_alarme_total", "alarm=\"energie\"", NULL, &statistik.alarme_energie);
+    metrik_messwert_registrieren("temperatur_celsius", NULL, "Zuletzt gelesene Temperatur", temperatur_metrik);
+    metrik_messwert_registrieren("tuer_offen", NULL, "Tür offen (1) oder geschlossen (0)", tuer_metrik);
+    metrik_messwert_registrieren("energie_watt", NULL, "Zuletzt gelesener Energieverbrauch", energie_metrik);
+}
+
+/**
+ * Momentanwerte für das Metrik-Register
+ */
+static double temperatur_metrik(void) {
+    return aktuelle_sensordaten.temperatur;
+}
+
+static double tuer_metrik(void) {
+    return aktuelle_sensordaten.tuer_offen;
+}
+
+static double energie_metrik(void) {
+    return aktuelle_sensordaten.energie_verbrauch;
+}
+
 /**
  * Beendet das Sensor-System
  */
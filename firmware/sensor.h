@@ -13,6 +13,19 @@ typedef struct {
     int datei_existiert;           // Flag ob Datei existiert
 } DateiInfo;
 
+// Zähler des Sensor-Systems
+typedef struct {
+    unsigned long lesevorgaenge;            // Aufrufe von sensor_werte_lesen
+    unsigned long lesefehler_temperatur;    // Datei fehlt oder nicht lesbar
+    unsigned long lesefehler_tuer;
+    unsigned long lesefehler_energie;
+    unsigned long unplausibel;              // Gelesen, aber außerhalb der Grenzen
+    unsigned long alarme_temperatur_hoch;   // Prüfungen mit ausgelöstem Alarm
+    unsigned long alarme_temperatur_niedrig;
+    unsigned long alarme_tuer;
+    unsigned long alarme_energie;
+} SensorStatistik;
+
 // Globale Sensor-Daten
 extern SensorDaten aktuelle_sensordaten;
 extern DateiInfo datei_infos[4]; // Für alle 4 Sensor-Dateien
@@ -34,7 +47,7 @@ int sensor_werte_lesen(SensorDaten* daten);
 
 /**
  * Schreibt simulierte Sensor-Werte in die Dateien
- * Wird alle 5 Sekunden aufgerufen um neue Zufallswerte zu generieren
+ * Wird vom Zeitplaner alle SENSOR_WRITE_INTERVAL Sekunden aufgerufen
  */
 void sensor_werte_simulieren_und_schreiben(void);
 
@@ -100,6 +113,12 @@ int sensor_alarme_pruefen(const SensorDaten* daten);
  */
 long tuer_offen_dauer_berechnen(long offen_seit);
 
+/**
+ * Liefert die Zähler des Sensor-Systems
+ * @param statistik Ziel-Struktur
+ */
+void sensor_statistik_abfragen(SensorStatistik* statistik);
+
 /**
  * Beendet das Sensor-System ordnungsgemäß
  */
@@ -9,84 +9,570 @@
 #include <unistd.h>
 #include <time.h>
 #include <string.h>
+#include <poll.h>
+#include <errno.h>
+#include <sys/signalfd.h>
 
 #include "config.h"
 #include "logging.h"
 #include "sensor.h"
 #include "display.h"
+#include "steuerung.h"
+#include "flugschreiber.h"
+#include "log_abfrage.h"
+#include "konsole.h"
+#include "i2c_bus.h"
+#include "i2c_sim.h"
+#include "lcd_hd44780.h"
+#include "status_datei.h"
+#include "terminal.h"
+#include "zeitplan.h"
+#include "latenz.h"
+#include "metriken.h"
+#include "spuren.h"
+#include "ressourcen.h"
 
 // Globale Variablen für Programmsteuerung
-static volatile int programm_laeuft = 1;
-static time_t letzter_sensor_check = 0;
-static time_t letzte_taster_pruefung = 0;
+static int programm_laeuft = 1;
 static int system_initialisiert = 0;
 
+// Signale werden über signalfd in der Hauptschleife verarbeitet. Ohne
+// signalfd setzen die Handler nur diese Merker (async-signal-sicher).
+static int signal_fd = -1;
+static volatile sig_atomic_t beenden_signal = 0;
+static volatile sig_atomic_t neu_laden_angefordert = 0;
+static volatile sig_atomic_t statistik_angefordert = 0;
+static volatile sig_atomic_t flugschreiber_sichern_angefordert = 0;
+static int start_kategorie_level[LOG_KAT_ANZAHL] = {-1, -1, -1, -1, -1}; // Von der Kommandozeile
+static int taster_datei_aktiv = 0;      // Optionaler Taster-Adapter (--taster-datei)
+static int simulation_aktiv = 1;        // Sensor-Simulation (--simulation)
+static int sensor_intervall_ms = SENSOR_UPDATE_INTERVAL * 1000; // --sensor-intervall
+static AusgabeModus start_ausgabe_modus = AUSGABE_BEIDE; // --ausgabe
+static TerminalModus start_terminal_modus = TERMINAL_AUTO; // --terminal
+static LogDauerhaftigkeit start_dauerhaftigkeit;          // --dauerhaftigkeit, --fehler-sync
+static int start_dauerhaftigkeit_gesetzt = 0;
+static unsigned long start_i2c_takt = I2C_TAKT_STANDARD; // --i2c-takt
+static int start_bildrate = DISPLAY_BILDRATE_STANDARD;   // --bildrate
+static int schnellstart = 0;            // --schnellstart
+
+// Startzeit-Messung: Zeitpunkte der Initialisierungsschritte ab Eintritt in main()
+#define START_PHASEN_MAX 16
+typedef struct {
+    const char* name;
+    uint64_t ende_us;
+} StartPhase;
+static uint64_t programm_start_us = 0;
+static StartPhase start_phasen[START_PHASEN_MAX];
+static int start_phasen_anzahl = 0;
+static uint64_t erster_messwert_us = 0;    // 0 = noch kein gültiger Messwert
+
+// Periodische Aufträge der Hauptschleife
+typedef enum {
+    AUFTRAG_SIMULATION = 0,
+    AUFTRAG_SENSOR,
+    AUFTRAG_TASTER,
+    AUFTRAG_STATUS,
+    AUFTRAG_LATENZ,
+    AUFTRAG_METRIKEN,
+    AUFTRAG_ANZAHL
+} AuftragIndex;
+static ZeitplanAuftrag auftraege[AUFTRAG_ANZAHL];
+static const char* const auftrag_labels[AUFTRAG_ANZAHL] = {
+    "auftrag=\"simulation\"", "auftrag=\"sensor\"", "auftrag=\"taster\"",
+    "auftrag=\"status\"", "auftrag=\"latenz\"", "auftrag=\"metriken\""
+};
+static unsigned long gemeldete_fristverletzungen[AUFTRAG_ANZAHL];
+
+// Latenz der Hauptschleife
+static LatenzHistogramm schleife_arbeit;       // Arbeitszeit pro Durchlauf (ohne Warten)
+static LatenzHistogramm schleife_aufwachen;    // Verspätung nach Ablauf der Wartezeit
+
+// Längste Wartezeit der Hauptschleife ohne fälligen Auftrag
+#define HAUPTSCHLEIFE_MAX_WARTEN_MS 1000
+
+// Laufzeit-Statistik für das Steuer-Kommando "stats"
+typedef struct {
+    time_t startzeit;
+    unsigned long iterationen;
+    unsigned long sensor_pruefungen;
+    unsigned long lesefehler;
+    unsigned long alarm_pruefungen;         // Prüfungen mit mindestens einem Problem
+    unsigned long log_level_wechsel;
+} LaufzeitStatistik;
+
+static LaufzeitStatistik statistik = {0};
+
 // Funktionsdeklarationen
 void signal_handler(int signal);
 void system_initialisieren(void);
 void hauptschleife(void);
 void sensor_daten_verarbeiten(void);
 void system_status_pruefen(void);
+void auftraege_einplanen(void);
 void taster_verarbeiten(void);
+void log_level_aenderung_anzeigen(int altes_level);
+void steuer_befehle_registrieren(void);
 void system_beenden(void);
 void hilfe_anzeigen(void);
 void version_anzeigen(void);
+int log_kategorie_option_verarbeiten(const char* option);
+static int schalter_aus_string(const char* text, int* wert);
+int log_abfrage_modus(int argc, char* argv[], int erstes_argument);
+int status_anzeigen(const char* pfad);
+static void start_phase(const char* name);
+static void erster_messwert_pruefen(const SensorDaten* daten);
+static void signale_einrichten(void);
+static void signale_abholen(void);
+static void signal_verarbeiten(int signal);
+static void abschalt_notfall(int signal);
+static void statistik_ins_log(void);
+static void befehl_stats(int argc, char* argv[], SteuerAntwort* antwort);
+static void metriken_registrieren(void);
+static double laufzeit_metrik(void);
+static double log_level_metrik(void);
 
 /**
- * Signal-Handler für sauberes Beenden
+ * Signal-Handler, falls signalfd nicht verfügbar ist
+ * Setzt nur Merker; Logging und alles Weitere erfolgt in der Hauptschleife
  */
 void signal_handler(int signal) {
     switch (signal) {
         case SIGINT:
-            LOG_INFO_MSG("SIGINT empfangen - Programm wird beendet");
+        case SIGTERM:
+            beenden_signal = signal;
+            break;
+        case SIGHUP:
+            neu_laden_angefordert = 1;
+            break;
+        case SIGUSR1:
+            statistik_angefordert = 1;
+            break;
+        case SIGUSR2:
+            flugschreiber_sichern_angefordert = 1;
             break;
+        default:
+            break;
+    }
+}
+
+/**
+ * Notausgang beim Herunterfahren: SIGALRM nach ABSCHALT_FRIST_MS oder ein
+ * weiteres SIGINT/SIGTERM. Nur async-signal-sichere Aufrufe; die Flags von
+ * stdout müssen nicht zurückgesetzt werden, die Konsole ändert sie nicht.
+ */
+static void abschalt_notfall(int signal) {
+    static const char frist[] = "Abschaltfrist überschritten - Programm wird sofort beendet\n";
+    static const char abbruch[] = "Herunterfahren abgebrochen\n";
+    
+    logging_notfall_sichern();
+    if (signal == SIGALRM) {
+        if (write(STDERR_FILENO, frist, sizeof(frist) - 1) < 0) {
+            // Nichts mehr zu tun
+        }
+    } else if (write(STDERR_FILENO, abbruch, sizeof(abbruch) - 1) < 0) {
+        // Nichts mehr zu tun
+    }
+    _exit(128 + signal);
+}
+
+/**
+ * Leitet SIGINT, SIGTERM, SIGHUP, SIGUSR1 und SIGUSR2 auf einen signalfd um
+ */
+static void signale_einrichten(void) {
+    sigset_t signale;
+    sigemptyset(&signale);
+    sigaddset(&signale, SIGINT);
+    sigaddset(&signale, SIGTERM);
+    sigaddset(&signale, SIGHUP);
+    sigaddset(&signale, SIGUSR1);
+    sigaddset(&signale, SIGUSR2);
+    
+    if (sigprocmask(SIG_BLOCK, &signale, NULL) == 0) {
+        signal_fd = signalfd(-1, &signale, SFD_NONBLOCK | SFD_CLOEXEC);
+        if (signal_fd >= 0) {
+            return;
+        }
+        sigprocmask(SIG_UNBLOCK, &signale, NULL);
+    }
+    
+    // Ersatz: klassische Handler ohne SA_RESTART, damit poll() aufwacht
+    struct sigaction aktion;
+    memset(&aktion, 0, sizeof(aktion));
+    aktion.sa_handler = signal_handler;
+    sigemptyset(&aktion.sa_mask);
+    sigaction(SIGINT, &aktion, NULL);
+    sigaction(SIGTERM, &aktion, NULL);
+    sigaction(SIGHUP, &aktion, NULL);
+    sigaction(SIGUSR1, &aktion, NULL);
+    sigaction(SIGUSR2, &aktion, NULL);
+}
+
+/**
+ * Holt angekommene Signale ab (signalfd oder Merker der Handler)
+ */
+static void signale_abholen(void) {
+    if (signal_fd >= 0) {
+        struct signalfd_siginfo info;
+        while (read(signal_fd, &info, sizeof(info)) == (ssize_t)sizeof(info)) {
+            signal_verarbeiten((int)info.ssi_signo);
+        }
+        return;
+    }
+    
+    if (beenden_signal != 0) {
+        int signal = beenden_signal;
+        beenden_signal = 0;
+        signal_verarbeiten(signal);
+    }
+    if (neu_laden_angefordert) {
+        neu_laden_angefordert = 0;
+        signal_verarbeiten(SIGHUP);
+    }
+    if (statistik_angefordert) {
+        statistik_angefordert = 0;
+        signal_verarbeiten(SIGUSR1);
+    }
+    if (flugschreiber_sichern_angefordert) {
+        flugschreiber_sichern_angefordert = 0;
+        signal_verarbeiten(SIGUSR2);
+    }
+}
+
+/**
+ * Reagiert auf ein Signal im normalen Programmablauf
+ */
+static void signal_verarbeiten(int signal) {
+    switch (signal) {
+        case SIGINT:
         case SIGTERM:
-            LOG_INFO_MSG("SIGTERM empfangen - Programm wird beendet");
+            LOG_INFO_F("%s empfangen - Programm wird beendet", signal == SIGINT ? "SIGINT" : "SIGTERM");
+            programm_laeuft = 0;
+            break;
+        case SIGHUP:
+            // Nach Log-Rotation: Dateien neu öffnen, Anzeige und Messwerte auffrischen
+            LOG_INFO_MSG("SIGHUP empfangen - Log-Dateien und Sensoren werden neu geladen");
+            logging_neu_oeffnen();
+            terminal_neu_zeichnen();
+            sensor_daten_verarbeiten();
+            break;
+        case SIGUSR1:
+            statistik_ins_log();
+            break;
+        case SIGUSR2:
+            flugschreiber_in_datei_sichern(FLUGSCHREIBER_DUMP_DATEI);
             break;
         default:
             LOG_WARNING_F("Unbekanntes Signal empfangen: %d", signal);
             break;
     }
-    programm_laeuft = 0;
+}
+
+/**
+ * Schreibt die Ausgabe des Kommandos "stats" zeilenweise ins Log (SIGUSR1)
+ */
+static void statistik_ins_log(void) {
+    char puffer[4096];
+    char* argv[] = {"stats", NULL};
+    SteuerAntwort antwort = {puffer, sizeof(puffer), 0};
+    puffer[0] = '\0';
+    befehl_stats(1, argv, &antwort);
+    
+    LOG_INFO_MSG("SIGUSR1 empfangen - Statistik:");
+    char* rest = NULL;
+    for (char* zeile = strtok_r(puffer, "\n", &rest); zeile != NULL; zeile = strtok_r(NULL, "\n", &rest)) {
+        LOG_INFO_F("  %s", zeile);
+    }
 }
 
 /**
  * Initialisiert alle Systemkomponenten
+ * Im Schnellstart liegt der erste Sensor-Messwert direkt hinter Logging und
+ * Flugschreiber; Display, Zeitplaner und Steuer-Socket folgen danach, Start-
+ * und Systeminfo-Einblendungen sowie das Konsolen-Banner entfallen.
  */
 void system_initialisieren(void) {
-    printf("=== Smart Kühlschrank Firmware v1.0 ===\n");
-    printf("Initialisierung wird gestartet...\n\n");
+    if (!schnellstart) {
+        printf("=== Smart Kühlschrank Firmware v1.0 ===\n");
+        printf("Initialisierung wird gestartet...\n\n");
+    }
     
-    // Signal-Handler registrieren
-    signal(SIGINT, signal_handler);
-    signal(SIGTERM, signal_handler);
+    // Ab hier laufen Konsolen-Ausgaben über die nicht blockierende Senke
+    konsole_initialisieren(start_ausgabe_modus);
+    terminal_initialisieren(start_terminal_modus);
+    
+    // Signale in die Hauptschleife umleiten
+    signale_einrichten();
     
     // Zufallsgenerator initialisieren
     srand(time(NULL));
+    statistik.startzeit = time(NULL);
+    start_phase("konsole");
     
     // Logging-System initialisieren
     logging_initialisieren();
+    start_phase("logging");
+    
+    // Flugschreiber zeichnet ab hier alle Level auf
+    if (flugschreiber_initialisieren(FLUGSCHREIBER_DATEI)) {
+        log_aufzeichnung_aktivieren(1);
+    }
     LOG_INFO_MSG("=== SYSTEM START ===");
     
+    // Per-Kategorie-Level von der Kommandozeile übernehmen
+    for (int kat = 0; kat < LOG_KAT_ANZAHL; kat++) {
+        if (start_kategorie_level[kat] >= 0) {
+            log_kategorie_level_setzen((LogKategorie)kat, start_kategorie_level[kat]);
+        }
+    }
+    if (start_dauerhaftigkeit_gesetzt) {
+        log_dauerhaftigkeit_setzen(&start_dauerhaftigkeit);
+    }
+    start_phase("flugschreiber");
+    
+    // Schnellstart: erster Messwert vor allem, was die Überwachung nicht braucht
+    if (schnellstart) {
+        sensor_system_initialisieren();
+        start_phase("sensor");
+        erster_messwert_pruefen(&aktuelle_sensordaten);
+    }
+    
+    // Simuliertes LCD am I2C-Bus als physisches Display
+    i2c_backend_setzen(i2c_sim_initialisieren(LCD_I2C_ADRESSE, start_i2c_takt));
+    if (lcd_initialisieren(LCD_I2C_ADRESSE)) {
+        display_treiber_setzen(lcd_display_treiber());
+    }
+    start_phase("lcd");
+    
+    // Periodische Aufträge der Hauptschleife
+    spuren_initialisieren();
+    auftraege_einplanen();
+    metriken_registrieren();
+    ressourcen_initialisieren();
+    
     // Display-System initialisieren
+    display_bildrate_setzen(start_bildrate);
     display_initialisieren();
-    
-    // Kurze Pause für Startbildschirm
-    sleep(2);
+    if (schnellstart) {
+        // Ohne Startbildschirm sofort die Messwerte zeigen
+        display_overlays_leeren();
+        display_aktualisieren(&aktuelle_sensordaten, log_level_abfragen());
+    }
+    start_phase("display");
     
     // Sensor-System initialisieren
-    sensor_system_initialisieren();
+    if (!schnellstart) {
+        sensor_system_initialisieren();
+        start_phase("sensor");
+        erster_messwert_pruefen(&aktuelle_sensordaten);
+    }
     
-    // Systeminformationen auf Display anzeigen
-    display_systeminfo_anzeigen();
-    sleep(3);
+    // Steuer-Socket öffnen (Firmware läuft auch ohne weiter)
+    steuer_befehle_registrieren();
+    steuerung_initialisieren(STEUER_SOCKET);
+    start_phase("steuerung");
+    
+    // Systeminformationen nach dem Startbildschirm einblenden (ohne Warten)
+    if (!schnellstart) {
+        display_systeminfo_anzeigen();
+    }
     
     system_initialisiert = 1;
     LOG_INFO_MSG("Alle Systeme erfolgreich initialisiert");
     
-    printf("\nSystem bereit! Drücken Sie Ctrl+C zum Beenden.\n");
-    printf("Log-Level ändern: echo '1' > %s\n", BUTTON_FILE);
-    printf("Sensor-Werte ändern: Dateien in %s bearbeiten\n\n", "Workspace/");
+    if (!schnellstart) {
+        konsole_printf("\nSystem bereit! Drücken Sie Ctrl+C zum Beenden.\n");
+        konsole_printf("Log-Level ändern: smart_fridge --befehl taster\n");
+        konsole_printf("Sensor-Werte ändern: Dateien in %s bearbeiten\n\n", "Workspace/");
+    }
+}
+
+/**
+ * Merkt das Ende eines Initialisierungsschritts für die Startzeit-Messung
+ */
+static void start_phase(const char* name) {
+    if (start_phasen_anzahl < START_PHASEN_MAX) {
+        start_phasen[start_phasen_anzahl].name = name;
+        start_phasen[start_phasen_anzahl].ende_us = latenz_jetzt_us();
+        start_phasen_anzahl++;
+    }
+}
+
+/**
+ * Meldet beim ersten gültigen Messwert die Startzeit mit Aufschlüsselung
+ */
+static void erster_messwert_pruefen(const SensorDaten* daten) {
+    if (erster_messwert_us != 0 || !daten->gueltig) {
+        return;
+    }
+    erster_messwert_us = latenz_jetzt_us();
+    
+    char aufschluesselung[256];
+    int pos = 0;
+    uint64_t vorher = programm_start_us;
+    for (int i = 0; i < start_phasen_anzahl && start_phasen[i].ende_us <= erster_messwert_us; i++) {
+        pos += snprintf(aufschluesselung + pos, sizeof(aufschluesselung) - (size_t)pos, "%s%s %.2f",
+                        i > 0 ? ", " : "", start_phasen[i].name,
+                        (double)(start_phasen[i].ende_us - vorher) / 1000.0);
+        vorher = start_phasen[i].ende_us;
+        if (pos >= (int)sizeof(aufschluesselung)) {
+            break;
+        }
+    }
+    
+    LOG_INFO_F("Erster gültiger Messwert nach %.2f ms (%s)",
+               (double)(erster_messwert_us - programm_start_us) / 1000.0, aufschluesselung);
+}
+
+/**
+ * Auftrag "simulation": neue Sensor-Werte in die Dateien schreiben
+ */
+static void auftrag_simulation(void* kontext) {
+    (void)kontext;
+    SPUR_START(spur);
+    sensor_werte_simulieren_und_schreiben();
+    SPUR_ENDE(spur, "sensor_werte_simulieren_und_schreiben");
+}
+
+/**
+ * Auftrag "sensor": Sensor-Dateien prüfen und verarbeiten
+ */
+static void auftrag_sensor(void* kontext) {
+    (void)kontext;
+    SPUR_START(spur);
+    sensor_daten_verarbeiten();
+    SPUR_ENDE(spur, "sensor_daten_verarbeiten");
+}
+
+/**
+ * Auftrag "taster": Taster-Datei abfragen (nur mit --taster-datei)
+ */
+static void auftrag_taster(void* kontext) {
+    (void)kontext;
+    SPUR_START(spur);
+    taster_verarbeiten();
+    SPUR_ENDE(spur, "taster_verarbeiten");
+}
+
+/**
+ * Auftrag "status": allgemeinen System-Status prüfen
+ */
+static void auftrag_status(void* kontext) {
+    (void)kontext;
+    SPUR_START(spur);
+    system_status_pruefen();
+    SPUR_ENDE(spur, "system_status_pruefen");
+}
+
+/**
+ * Auftrag "latenz": Zusammenfassung ins Log, neue Fristverletzungen als Warnung
+ */
+static void auftrag_latenz(void* kontext) {
+    (void)kontext;
+    char text[96];
+    
+    for (int i = 0; i < AUFTRAG_ANZAHL; i++) {
+        const ZeitplanAuftrag* a = &auftraege[i];
+        if (a->name == NULL || a->verspaetung.anzahl == 0) {
+            continue;
+        }
+        
+        unsigned long neu = a->fristverletzungen - gemeldete_fristverletzungen[i];
+        gemeldete_fristverletzungen[i] = a->fristverletzungen;
+        if (neu > 0) {
+            LOG_WARNING_F("Auftrag %s: %lu Fristverletzungen (Start %s)", a->name, neu,
+                          latenz_zusammenfassung(&a->verspaetung, text, sizeof(text)));
+        } else {
+            LOG_DEBUG_F("Auftrag %s: Start %s", a->name,
+                        latenz_zusammenfassung(&a->verspaetung, text, sizeof(text)));
+        }
+    }
+    
+    LOG_INFO_F("Latenz Hauptschleife: Arbeit %s",
+               latenz_zusammenfassung(&schleife_arbeit, text, sizeof(text)));
+}
+
+/**
+ * Auftrag "metriken": Metrik-Datei für den lokalen Collector schreiben
+ */
+static void auftrag_metriken(void* kontext) {
+    (void)kontext;
+    int ergebnis = metriken_datei_schreiben(METRIKEN_DATEI);
+    if (ergebnis == 0) {
+        LOG_WARNING_F("Metrik-Datei %s konnte nicht geschrieben werden", METRIKEN_DATEI);
+    } else if (ergebnis < 0) {
+        LOG_WARNING_F("Metrik-Datei %s gekürzt: Export größer als der Puffer", METRIKEN_DATEI);
+    }
+}
+
+/**
+ * Registriert die periodischen Aufträge beim Zeitplaner
+ * Toleranz jeweils 10 % des Intervalls, damit Aufträge gebündelt laufen
+ */
+void auftraege_einplanen(void) {
+    zeitplan_initialisieren();
+    
+    if (simulation_aktiv) {
+        zeitplan_einplanen(&auftraege[AUFTRAG_SIMULATION], "simulation",
+                           SENSOR_WRITE_INTERVAL * 1000, SENSOR_WRITE_INTERVAL * 1000,
+                           SENSOR_WRITE_INTERVAL * 100, auftrag_simulation, NULL);
+    }
+    zeitplan_einplanen(&auftraege[AUFTRAG_SENSOR], "sensor",
+                       0, sensor_intervall_ms,
+                       sensor_intervall_ms / 10, auftrag_sensor, NULL);
+    if (taster_datei_aktiv) {
+        zeitplan_einplanen(&auftraege[AUFTRAG_TASTER], "taster",
+                           0, TASTER_INTERVAL * 1000,
+                           TASTER_INTERVAL * 100, auftrag_taster, NULL);
+    }
+    zeitplan_einplanen(&auftraege[AUFTRAG_STATUS], "status",
+                       0, STATUS_INTERVAL * 1000,
+                       STATUS_INTERVAL * 100, auftrag_status, NULL);
+    zeitplan_einplanen(&auftraege[AUFTRAG_LATENZ], "latenz",
+                       LATENZ_BERICHT_INTERVAL * 1000, LATENZ_BERICHT_INTERVAL * 1000,
+                       LATENZ_BERICHT_INTERVAL * 100, auftrag_latenz, NULL);
+    zeitplan_einplanen(&auftraege[AUFTRAG_METRIKEN], "metriken",
+                       0, METRIKEN_INTERVAL * 1000,
+                       METRIKEN_INTERVAL * 100, auftrag_metriken, NULL);
+}
+
+/**
+ * Meldet Zähler und Histogramme der Hauptschleife beim Metrik-Register an
+ */
+static void metriken_registrieren(void) {
+    metrik_messwert_registrieren("laufzeit_sekunden", NULL, "Sekunden seit Programmstart", laufzeit_metrik);
+    metrik_messwert_registrieren("log_level", NULL, "Globales Log-Level (0 = DEBUG .. 3 = FEHLER)",
+                                 log_level_metrik);
+    metrik_zaehler_registrieren("schleife_iterationen_total", NULL, "Durchläufe der Hauptschleife",
+                                &statistik.iterationen);
+    metrik_histogramm_registrieren("schleife_arbeit_sekunden", NULL,
+                                   "Arbeitszeit pro Durchlauf der Hauptschleife (ohne Warten)", &schleife_arbeit);
+    metrik_histogramm_registrieren("schleife_aufwachen_sekunden", NULL,
+                                   "Verspätung beim Aufwachen nach Ablauf der Wartezeit", &schleife_aufwachen);
+    
+    // Nur eingeplante Aufträge (der Taster-Adapter ist optional)
+    for (int i = 0; i < AUFTRAG_ANZAHL; i++) {
+        if (auftraege[i].name != NULL) {
+            metrik_histogramm_registrieren("auftrag_verspaetung_sekunden", auftrag_labels[i],
+                                           "Start-Verspätung periodischer Aufträge", &auftraege[i].verspaetung);
+        }
+    }
+    for (int i = 0; i < AUFTRAG_ANZAHL; i++) {
+        if (auftraege[i].name != NULL) {
+            metrik_zaehler_registrieren("auftrag_fristverletzungen_total", auftrag_labels[i],
+                                        "Starts später als Frist + Toleranz", &auftraege[i].fristverletzungen);
+        }
+    }
+}
+
+/**
+ * Momentanwerte für das Metrik-Register
+ */
+static double laufzeit_metrik(void) {
+    return (double)(latenz_jetzt_us() - programm_start_us) / 1e6;
+}
+
+static double log_level_metrik(void) {
+    return log_level_abfragen();
 }
 
 /**
@@ -96,28 +582,90 @@ void hauptschleife(void) {
     LOG_INFO_MSG("Hauptschleife gestartet");
     
     while (programm_laeuft) {
-        time_t jetzt = time(NULL);
+        uint64_t anfang_us = latenz_jetzt_us();
+        SPUR_START(spur_durchlauf);
         
-        // Sensor-Simulation (alle 5 Sekunden neue Werte schreiben)
-        sensor_werte_simulieren_und_schreiben();
+        // Fällige periodische Aufträge (Simulation, Sensoren, Taster, Status, Latenz, Metriken)
+        SPUR_START(spur_zeitplan);
+        zeitplan_abarbeiten();
+        SPUR_ENDE(spur_zeitplan, "zeitplan_abarbeiten");
         
-        // Sensor-Daten verarbeiten (jede Sekunde prüfen)
-        if (jetzt - letzter_sensor_check >= SENSOR_UPDATE_INTERVAL) {
-            sensor_daten_verarbeiten();
-            letzter_sensor_check = jetzt;
+        // Bis zur nächsten Frist schlafen: nächster Auftrag, nächstes
+        // Display-Bild oder ablaufende Einblendung; Steuer-Kommandos und
+        // aufnahmebereites stdout wecken früher
+        int warten = zeitplan_wartezeit_ms(HAUPTSCHLEIFE_MAX_WARTEN_MS);
+        warten = steuerung_wartezeit_ms(display_wartezeit_ms(logging_wartezeit_ms(warten)));
+        KonsolenStatistik konsole;
+        konsole_statistik_abfragen(&konsole);
+        
+        struct pollfd pfd[2 + STEUER_MAX_VERBINDUNGEN + 1];
+        int anzahl = 0;
+        int signal_index = -1;
+        if (signal_fd >= 0) {
+            pfd[anzahl].fd = signal_fd;
+            pfd[anzahl].events = POLLIN;
+            pfd[anzahl].revents = 0;
+            signal_index = anzahl++;
+        }
+        int steuer_erster = anzahl;
+        anzahl += steuerung_poll_eintragen(&pfd[anzahl], STEUER_MAX_VERBINDUNGEN + 1);
+        int steuer_ende = anzahl;
+        if (konsole.puffer_belegt > 0) {
+            pfd[anzahl].fd = STDOUT_FILENO;
+            pfd[anzahl].events = POLLOUT;
+            pfd[anzahl].revents = 0;
+            anzahl++;
         }
+        uint64_t vor_warten_us = latenz_jetzt_us();
+        SPUR_ENDE(spur_durchlauf, "hauptschleife.vor_poll");
+        int bereit = poll(pfd, (nfds_t)anzahl, warten);
+        uint64_t nach_warten_us = latenz_jetzt_us();
+        SPUR_START(spur_nach_warten);
         
-        // Taster-Eingabe prüfen (alle 2 Sekunden)
-        if (jetzt - letzte_taster_pruefung >= 2) {
-            taster_verarbeiten();
-            letzte_taster_pruefung = jetzt;
+        // Wie spät weckt der Kernel nach Ablauf der Wartezeit?
+        if (bereit == 0 && warten > 0) {
+            uint64_t soll_us = vor_warten_us + (uint64_t)warten * 1000;
+            latenz_erfassen(&schleife_aufwachen, nach_warten_us > soll_us ? nach_warten_us - soll_us : 0);
+        }
+        if (signal_index < 0 || (bereit > 0 && (pfd[signal_index].revents & POLLIN))) {
+            signale_abholen();
+            if (!programm_laeuft) {
+                break;
+            }
+        }
+        // Steuer-Socket und offene Anfragen; ohne Ereignis (Zeitablauf)
+        // werden Anfragen mit abgelaufener Frist geschlossen
+        int steuer_bereit = (bereit == 0);
+        for (int i = steuer_erster; i < steuer_ende; i++) {
+            if (pfd[i].revents != 0) {
+                steuer_bereit = 1;
+            }
         }
+        if (steuer_bereit) {
+            SPUR_START(spur_steuerung);
+            steuerung_verarbeiten();
+            SPUR_ENDE(spur_steuerung, "steuerung_verarbeiten");
+        }
+        
+        // Einblendungen ablaufen lassen, gesammelte Änderungen ausgeben
+        SPUR_START(spur_display);
+        display_zyklus();
+        SPUR_ENDE(spur_display, "display_zyklus");
         
-        // System-Status prüfen
-        system_status_pruefen();
+        // Gruppen-Commit: Log-Einträge dieses Durchlaufs gemeinsam schreiben.
+        // Einziger Aufrufer; logging_wartezeit_ms() weckt die Schleife für
+        // zeitgesteuerte Syncs, die Wartezeit ist ohnehin höchstens 1 s.
+        SPUR_START(spur_logging);
+        logging_zyklus();
+        SPUR_ENDE(spur_logging, "logging_zyklus");
         
-        // Kurze Pause um CPU-Last zu reduzieren
-        usleep(100000); // 100ms
+        // Gepufferte Konsolen-Ausgabe weiterreichen, soweit stdout sie annimmt
+        SPUR_START(spur_konsole);
+        konsole_abarbeiten();
+        SPUR_ENDE(spur_konsole, "konsole_abarbeiten");
+        SPUR_ENDE(spur_nach_warten, "hauptschleife.nach_poll");
+        statistik.iterationen++;
+        latenz_erfassen(&schleife_arbeit, (vor_warten_us - anfang_us) + (latenz_jetzt_us() - nach_warten_us));
     }
     
     LOG_INFO_MSG("Hauptschleife beendet");
@@ -135,31 +683,35 @@ void sensor_daten_verarbeiten(void) {
     aenderungen += datei_wurde_geaendert(DOOR_FILE, TUER_DATEI_INDEX);
     aenderungen += datei_wurde_geaendert(ENERGY_FILE, ENERGIE_DATEI_INDEX);
     
+    statistik.sensor_pruefungen++;
+    
     // Sensor-Werte lesen (immer, auch ohne Änderungen für Zeitstempel-Updates)
     if (sensor_werte_lesen(&neue_daten)) {
+        erster_messwert_pruefen(&neue_daten);
+        
         // Daten mit vorherigen vergleichen für Änderungslog
         if (memcmp(&aktuelle_sensordaten, &neue_daten, sizeof(SensorDaten)) != 0 || aenderungen > 0) {
-            LOG_DEBUG_MSG("Sensor-Daten aktualisiert");
+            LOG_K_MSG(LOG_KAT_SENSOR, LOG_DEBUG, "Sensor-Daten aktualisiert");
             
             // Temperatur-Änderung loggen
             if (aktuelle_sensordaten.temperatur != neue_daten.temperatur) {
-                LOG_INFO_F("Temperatur geändert: %.2f°C -> %.2f°C", 
-                          aktuelle_sensordaten.temperatur, neue_daten.temperatur);
+                LOG_K_F(LOG_KAT_SENSOR, LOG_INFO, "Temperatur geändert: %.2f°C -> %.2f°C",
+                        aktuelle_sensordaten.temperatur, neue_daten.temperatur);
             }
             
             // Tür-Status-Änderung loggen
             if (aktuelle_sensordaten.tuer_offen != neue_daten.tuer_offen) {
-                LOG_INFO_F("Tür-Status geändert: %s -> %s",
-                          aktuelle_sensordaten.tuer_offen ? "offen" : "geschlossen",
-                          neue_daten.tuer_offen ? "offen" : "geschlossen");
+                LOG_K_F(LOG_KAT_SENSOR, LOG_INFO, "Tür-Status geändert: %s -> %s",
+                        aktuelle_sensordaten.tuer_offen ? "offen" : "geschlossen",
+                        neue_daten.tuer_offen ? "offen" : "geschlossen");
             }
             
             // Energie-Änderung loggen (nur bei größeren Änderungen)
             float energie_diff = neue_daten.energie_verbrauch - aktuelle_sensordaten.energie_verbrauch;
             if (energie_diff > 10.0f || energie_diff < -10.0f) {
-                LOG_INFO_F("Energieverbrauch geändert: %.1fW -> %.1fW (Δ%.1fW)",
-                          aktuelle_sensordaten.energie_verbrauch, 
-                          neue_daten.energie_verbrauch, energie_diff);
+                LOG_K_F(LOG_KAT_SENSOR, LOG_INFO, "Energieverbrauch geändert: %.1fW -> %.1fW (Δ%.1fW)",
+                        aktuelle_sensordaten.energie_verbrauch,
+                        neue_daten.energie_verbrauch, energie_diff);
             }
             
             // Aktuelle Daten aktualisieren
@@ -169,20 +721,22 @@ void sensor_daten_verarbeiten(void) {
         // Alarme prüfen
         int probleme = sensor_alarme_pruefen(&neue_daten);
         if (probleme > 0) {
-            LOG_WARNING_F("Sensor-Alarme erkannt: %d Problem(e)", probleme);
+            statistik.alarm_pruefungen++;
+            LOG_ALARM_F("Sensor-Alarme erkannt: %d Problem(e)", probleme);
         }
         
         // Display aktualisieren
         display_aktualisieren(&neue_daten, log_level_abfragen());
         
     } else {
-        LOG_ERROR_MSG("Fehler beim Lesen der Sensor-Daten");
+        statistik.lesefehler++;
+        LOG_K_MSG(LOG_KAT_SENSOR, LOG_ERROR, "Fehler beim Lesen der Sensor-Daten");
         display_fehler_anzeigen("Sensor-Lesefehler");
     }
 }
 
 /**
- * Verarbeitet Taster-Eingaben für Log-Level-Änderung
+ * Verarbeitet den optionalen Taster-Datei-Adapter
  */
 void taster_verarbeiten(void) {
     int altes_level = log_level_abfragen();
@@ -190,40 +744,402 @@ void taster_verarbeiten(void) {
     // Taster prüfen und Log-Level ggf. erhöhen
     taster_pruefen_und_log_level_erhoehen();
     
+    log_level_aenderung_anzeigen(altes_level);
+}
+
+/**
+ * Zeigt eine Log-Level-Änderung auf dem Display an
+ */
+void log_level_aenderung_anzeigen(int altes_level) {
     int neues_level = log_level_abfragen();
     
     // Bei Änderung Display aktualisieren
     if (altes_level != neues_level) {
+        statistik.log_level_wechsel++;
         LOG_INFO_F("Log-Level durch Taster geändert: %d -> %d", altes_level, neues_level);
         display_aktualisieren(&aktuelle_sensordaten, neues_level);
         
-        // Kurze Bestätigung auf Display
+        // Kurze Bestätigung auf Display; läuft in display_zyklus() ab
         char meldung[40];
         snprintf(meldung, sizeof(meldung), "Log-Level: %s", log_level_zu_string(neues_level));
-        display_warnung_anzeigen(meldung);
-        
-        // Nach 2 Sekunden normales Display wiederherstellen
-        sleep(2);
-        display_aktualisieren(&aktuelle_sensordaten, neues_level);
+        display_overlay_zeigen(NULL, meldung, DISPLAY_MELDUNG_DAUER_MS, DISPLAY_PRIO_INFO);
     }
 }
 
 /**
- * Überprüft allgemeinen System-Status
+ * Steuer-Kommando "taster": simulierter Tastendruck
  */
-void system_status_pruefen(void) {
-    static time_t letzter_status_check = 0;
-    time_t jetzt = time(NULL);
+static void befehl_taster(int argc, char* argv[], SteuerAntwort* antwort) {
+    (void)argc;
+    (void)argv;
+    
+    int altes_level = log_level_abfragen();
+    log_level_weiterschalten();
+    log_level_aenderung_anzeigen(altes_level);
+    steuerung_antwort(antwort, "Log-Level: %s\n", log_level_zu_string((LogLevel)log_level_abfragen()));
+}
+
+/**
+ * Steuer-Kommando "stats": Laufzeit-Statistik ausgeben und loggen
+ */
+static void befehl_stats(int argc, char* argv[], SteuerAntwort* antwort) {
+    (void)argc;
+    (void)argv;
+    
+    long laufzeit = (long)(time(NULL) - statistik.startzeit);
+    steuerung_antwort(antwort, "laufzeit_s %ld\n", laufzeit);
+    steuerung_antwort(antwort, "iterationen %lu\n", statistik.iterationen);
+    steuerung_antwort(antwort, "sensor_pruefungen %lu\n", statistik.sensor_pruefungen);
+    steuerung_antwort(antwort, "lesefehler %lu\n", statistik.lesefehler);
+    steuerung_antwort(antwort, "alarm_pruefungen %lu\n", statistik.alarm_pruefungen);
+    steuerung_antwort(antwort, "log_level_wechsel %lu\n", statistik.log_level_wechsel);
+    
+    LogStatistik log;
+    log_statistik_abfragen(&log);
+    steuerung_antwort(antwort, "log_geschrieben %lu\n", log.geschrieben);
+    steuerung_antwort(antwort, "log_unterdrueckt %lu\n", log.unterdrueckt);
+    steuerung_antwort(antwort, "log_zusammenfassungen %lu\n", log.zusammenfassungen);
+    steuerung_antwort(antwort, "log_flushes %lu\n", log.flushes);
+    steuerung_antwort(antwort, "log_syncs %lu\n", log.syncs);
+    
+    DisplayStatistik display;
+    display_statistik_abfragen(&display);
+    steuerung_antwort(antwort, "display_abgleiche %lu\n", display.abgleiche);
+    steuerung_antwort(antwort, "display_bereiche %lu\n", display.laeufe);
+    steuerung_antwort(antwort, "display_zeichen %lu\n", display.zeichen);
+    steuerung_antwort(antwort, "display_zeichen_voll %lu\n", display.zeichen_voll);
+    steuerung_antwort(antwort, "display_formatierungen %lu\n", display.formatierungen);
+    steuerung_antwort(antwort, "display_formatierungen_gespart %lu\n", display.formatierungen_gespart);
+    steuerung_antwort(antwort, "display_overlays_verworfen %lu\n", display.overlays_verworfen);
+    steuerung_antwort(antwort, "display_bildrate %d\n", display_bildrate_abfragen());
+    steuerung_antwort(antwort, "display_bilder %lu\n", display.bilder);
+    steuerung_antwort(antwort, "display_zusammengefasst %lu\n", display.zusammengefasst);
+    
+    I2CStatistik i2c;
+    I2CSimZeiten i2c_zeiten;
+    i2c_statistik_abfragen(&i2c);
+    i2c_sim_zeiten_abfragen(&i2c_zeiten);
+    steuerung_antwort(antwort, "i2c_transaktionen %lu\n", i2c.transaktionen);
+    steuerung_antwort(antwort, "i2c_bytes %lu\n", i2c.bytes);
+    steuerung_antwort(antwort, "i2c_fehler %lu\n", i2c.fehler);
+    steuerung_antwort(antwort, "i2c_bus_zeit_us %llu\n", (unsigned long long)(i2c_zeiten.bus_zeit_ns / 1000));
+    
+    ZeitplanStatistik zeitplan;
+    zeitplan_statistik_abfragen(&zeitplan);
+    steuerung_antwort(antwort, "zeitplan_ausfuehrungen %lu\n", zeitplan.ausfuehrungen);
+    steuerung_antwort(antwort, "zeitplan_eingeplant %lu\n", zeitplan.eingeplant);
+    steuerung_antwort(antwort, "zeitplan_umsortiert %lu\n", zeitplan.umsortiert);
+    steuerung_antwort(antwort, "zeitplan_ticks %lu\n", zeitplan.ticks);
+    steuerung_antwort(antwort, "zeitplan_fristverletzungen %lu\n", zeitplan.fristverletzungen);
+    steuerung_antwort(antwort, "schleife_arbeit_p50_us %llu\n",
+                      (unsigned long long)latenz_perzentil(&schleife_arbeit, 0.50));
+    steuerung_antwort(antwort, "schleife_arbeit_p99_us %llu\n",
+                      (unsigned long long)latenz_perzentil(&schleife_arbeit, 0.99));
+    steuerung_antwort(antwort, "schleife_arbeit_max_us %llu\n", (unsigned long long)schleife_arbeit.max_us);
+    steuerung_antwort(antwort, "start_erster_messwert_us %llu\n",
+                      (unsigned long long)(erster_messwert_us ? erster_messwert_us - programm_start_us : 0));
+    
+    KonsolenStatistik konsole;
+    konsole_statistik_abfragen(&konsole);
+    steuerung_antwort(antwort, "konsole_geschrieben_bytes %lu\n", konsole.geschriebene_bytes);
+    steuerung_antwort(antwort, "konsole_verworfen_bytes %lu\n", konsole.verworfene_bytes);
+    steuerung_antwort(antwort, "konsole_verworfen_eintraege %lu\n", konsole.verworfene_eintraege);
+    steuerung_antwort(antwort, "konsole_puffer_belegt %zu\n", konsole.puffer_belegt);
+    
+    TerminalStatistik terminal;
+    terminal_statistik_abfragen(&terminal);
+    steuerung_antwort(antwort, "terminal_ansi %d\n", terminal_aktiv());
+    steuerung_antwort(antwort, "terminal_aktualisierungen %lu\n", terminal.aktualisierungen);
+    steuerung_antwort(antwort, "terminal_neuzeichnungen %lu\n", terminal.neuzeichnungen);
+    steuerung_antwort(antwort, "terminal_bytes %lu\n", terminal.bytes);
+    steuerung_antwort(antwort, "terminal_bytes_rahmen %lu\n", terminal.bytes_rahmen);
+    
+    LOG_INFO_F("Statistik: %ld s, %lu Iterationen, %lu Sensor-Prüfungen, %lu Lesefehler, %lu Alarm-Prüfungen",
+               laufzeit, statistik.iterationen, statistik.sensor_pruefungen,
+               statistik.lesefehler, statistik.alarm_pruefungen);
+}
+
+/**
+ * Steuer-Kommando "refresh": Display-Ausgabe erzwingen
+ */
+static void befehl_refresh(int argc, char* argv[], SteuerAntwort* antwort) {
+    (void)argc;
+    (void)argv;
+    
+    terminal_neu_zeichnen();
+    display_ausgeben();
+    display_in_datei_schreiben(DISPLAY_DATEI);
+    steuerung_antwort(antwort, "OK\n");
+}
+
+/**
+ * Steuer-Kommando "snapshot": aktuellen Zustand ausgeben
+ */
+static void befehl_snapshot(int argc, char* argv[], SteuerAntwort* antwort) {
+    (void)argc;
+    (void)argv;
+    
+    steuerung_antwort(antwort, "temperatur %.2f\n", aktuelle_sensordaten.temperatur);
+    steuerung_antwort(antwort, "tuer_offen %d\n", aktuelle_sensordaten.tuer_offen);
+    steuerung_antwort(antwort, "tuer_offen_seit %ld\n", aktuelle_sensordaten.tuer_offen_seit);
+    steuerung_antwort(antwort, "energie %.2f\n", aktuelle_sensordaten.energie_verbrauch);
+    steuerung_antwort(antwort, "gueltig %d\n", aktuelle_sensordaten.gueltig);
+    steuerung_antwort(antwort, "log_level %d\n", log_level_abfragen());
+    steuerung_antwort(antwort, "zeile1 %s\n", display_puffer.zeile1);
+    steuerung_antwort(antwort, "zeile2 %s\n", display_puffer.zeile2);
+}
+
+/**
+ * Callback: Flugschreiber-Zeile an Steuer-Antwort anhängen
+ */
+static void flugschreiber_zeile_antworten(const char* zeile, void* kontext) {
+    steuerung_antwort((SteuerAntwort*)kontext, "%s", zeile);
+}
+
+/**
+ * Steuer-Kommando "flugschreiber": letzte Einträge ausgeben oder sichern
+ */
+static void befehl_flugschreiber(int argc, char* argv[], SteuerAntwort* antwort) {
+    if (argc >= 2 && strcmp(argv[1], "sichern") == 0) {
+        long anzahl = flugschreiber_in_datei_sichern(FLUGSCHREIBER_DUMP_DATEI);
+        steuerung_antwort(antwort, "%ld Einträge nach %s gesichert\n", anzahl, FLUGSCHREIBER_DUMP_DATEI);
+        return;
+    }
+    
+    size_t anzahl = (argc >= 2) ? (size_t)strtoul(argv[1], NULL, 10) : 50;
+    flugschreiber_ausgeben(anzahl, flugschreiber_zeile_antworten, antwort);
+}
+
+/**
+ * Steuer-Kommando "dauerhaftigkeit": Regel der Log-Datei abfragen oder setzen
+ */
+static void befehl_dauerhaftigkeit(int argc, char* argv[], SteuerAntwort* antwort) {
+    LogDauerhaftigkeit regel;
+    log_dauerhaftigkeit_abfragen(&regel);
+    
+    if (argc >= 2) {
+        if (!log_dauerhaftigkeit_aus_string(argv[1], &regel)) {
+            steuerung_antwort(antwort, "FEHLER: unbekannte Stufe '%s' (keine, batch, sync[:MS[:N]])\n", argv[1]);
+            return;
+        }
+        if (argc >= 3 && !schalter_aus_string(argv[2], &regel.fehler_sofort)) {
+            steuerung_antwort(antwort, "FEHLER: unbekannter Wert '%s' für fehler_sofort (an, aus)\n", argv[2]);
+            return;
+        }
+        log_dauerhaftigkeit_setzen(&regel);
+    }
+    
+    steuerung_antwort(antwort, "stufe %s\n", log_dauer_stufe_zu_string(regel.stufe));
+    steuerung_antwort(antwort, "sync_intervall_ms %d\n", regel.sync_intervall_ms);
+    steuerung_antwort(antwort, "sync_eintraege %d\n", regel.sync_eintraege);
+    steuerung_antwort(antwort, "fehler_sofort %s\n", regel.fehler_sofort ? "an" : "aus");
+}
+
+/**
+ * Steuer-Kommando "lcd": Inhalt und Bus-Zeiten des simulierten LCD
+ */
+static void befehl_lcd(int argc, char* argv[], SteuerAntwort* antwort) {
+    (void)argc;
+    (void)argv;
+    
+    char zeile[DISPLAY_COLS + 1];
+    I2CStatistik i2c;
+    I2CSimZeiten zeiten;
+    i2c_statistik_abfragen(&i2c);
+    i2c_sim_zeiten_abfragen(&zeiten);
+    
+    i2c_sim_zeile_lesen(0, zeile);
+    steuerung_antwort(antwort, "ddram1 |%s|\n", zeile);
+    i2c_sim_zeile_lesen(1, zeile);
+    steuerung_antwort(antwort, "ddram2 |%s|\n", zeile);
+    steuerung_antwort(antwort, "takt_hz %lu\n", i2c_sim_takt());
+    steuerung_antwort(antwort, "transaktionen %lu\n", i2c.transaktionen);
+    steuerung_antwort(antwort, "bytes %lu\n", i2c.bytes);
+    steuerung_antwort(antwort, "befehle %lu\n", zeiten.befehle);
+    steuerung_antwort(antwort, "zeichen %lu\n", zeiten.zeichen);
+    steuerung_antwort(antwort, "bus_zeit_us %llu\n", (unsigned long long)(zeiten.bus_zeit_ns / 1000));
+    steuerung_antwort(antwort, "warte_zeit_us %llu\n", (unsigned long long)(zeiten.warte_zeit_ns / 1000));
+}
+
+/**
+ * Steuer-Kommando "zeitplan": periodische Aufträge und ihre Zähler
+ */
+static void befehl_zeitplan(int argc, char* argv[], SteuerAntwort* antwort) {
+    (void)argc;
+    (void)argv;
+    
+    steuerung_antwort(antwort, "%-12s %9s %9s %12s %8s %10s\n",
+                      "auftrag", "interv_ms", "toler_ms", "ausfuehrung", "verpasst", "fristverl");
+    for (int i = 0; i < AUFTRAG_ANZAHL; i++) {
+        const ZeitplanAuftrag* a = &auftraege[i];
+        if (a->name == NULL) {
+            continue;
+        }
+        steuerung_antwort(antwort, "%-12s %9d %9d %12lu %8lu %10lu\n",
+                          a->name, a->intervall_ms, a->toleranz_ms,
+                          a->ausfuehrungen, a->verpasst, a->fristverletzungen);
+    }
+}
+
+/**
+ * Gibt eine Zeile der Latenz-Tabelle aus (Werte in Mikrosekunden)
+ */
+static void latenz_zeile(SteuerAntwort* antwort, const char* name, const LatenzHistogramm* h) {
+    steuerung_antwort(antwort, "%-20s %8lu %10llu %10llu %10llu\n", name, h->anzahl,
+                      (unsigned long long)latenz_perzentil(h, 0.50),
+                      (unsigned long long)latenz_perzentil(h, 0.99),
+                      (unsigned long long)h->max_us);
+}
+
+/**
+ * Steuer-Kommando "latenz": Start-Verspätung und Laufzeit je Auftrag,
+ * Arbeitszeit und Aufwach-Verspätung der Hauptschleife
+ */
+static void befehl_latenz(int argc, char* argv[], SteuerAntwort* antwort) {
+    if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+        for (int i = 0; i < AUFTRAG_ANZAHL; i++) {
+            zeitplan_latenz_zuruecksetzen(&auftraege[i]);
+            gemeldete_fristverletzungen[i] = 0;
+        }
+        latenz_zuruecksetzen(&schleife_arbeit);
+        latenz_zuruecksetzen(&schleife_aufwachen);
+        steuerung_antwort(antwort, "OK\n");
+        return;
+    }
+    
+    char name[32];
+    steuerung_antwort(antwort, "%-20s %8s %10s %10s %10s\n", "messung", "anzahl", "p50_us", "p99_us", "max_us");
+    for (int i = 0; i < AUFTRAG_ANZAHL; i++) {
+        const ZeitplanAuftrag* a = &auftraege[i];
+        if (a->name == NULL) {
+            continue;
+        }
+        snprintf(name, sizeof(name), "%s.start", a->name);
+        latenz_zeile(antwort, name, &a->verspaetung);
+        snprintf(name, sizeof(name), "%s.laufzeit", a->name);
+        latenz_zeile(antwort, name, &a->laufzeit);
+    }
+    latenz_zeile(antwort, "schleife.arbeit", &schleife_arbeit);
+    latenz_zeile(antwort, "schleife.aufwachen", &schleife_aufwachen);
+}
+
+/**
+ * Kommando "start": Dauer der Initialisierungsschritte ab main()
+ */
+static void befehl_start(int argc, char* argv[], SteuerAntwort* antwort) {
+    (void)argc;
+    (void)argv;
+    
+    steuerung_antwort(antwort, "modus %s\n", schnellstart ? "schnellstart" : "normal");
+    uint64_t vorher = programm_start_us;
+    for (int i = 0; i < start_phasen_anzahl; i++) {
+        steuerung_antwort(antwort, "%-14s %8llu us  (ab Start %llu us)\n", start_phasen[i].name,
+                          (unsigned long long)(start_phasen[i].ende_us - vorher),
+                          (unsigned long long)(start_phasen[i].ende_us - programm_start_us));
+        vorher = start_phasen[i].ende_us;
+    }
+    if (erster_messwert_us != 0) {
+        steuerung_antwort(antwort, "erster_messwert %llu us\n",
+                          (unsigned long long)(erster_messwert_us - programm_start_us));
+    } else {
+        steuerung_antwort(antwort, "erster_messwert -\n");
+    }
+}
+
+/**
+ * Kommando "metriken": alle Metriken im Prometheus-Textformat
+ */
+static void befehl_metriken(int argc, char* argv[], SteuerAntwort* antwort) {
+    (void)argc;
+    (void)argv;
+    int gekuerzt;
+    size_t laenge = metriken_exportieren(antwort->puffer + antwort->laenge,
+                                         antwort->groesse - antwort->laenge, &gekuerzt);
+    if (gekuerzt) {
+        // Keine unvollständige Ausgabe liefern; die Metrik-Datei bleibt lesbar
+        antwort->puffer[antwort->laenge] = '\0';
+        steuerung_antwort(antwort, "FEHLER: Metriken passen nicht in die Antwort (%d Bytes), siehe %s\n",
+                          STEUER_ANTWORT_GROESSE, METRIKEN_DATEI);
+        return;
+    }
+    antwort->laenge += laenge;
+}
+
+/**
+ * Kommando "spuren": Zeitspuren als Chrome-Trace-JSON sichern
+ */
+static void befehl_spuren(int argc, char* argv[], SteuerAntwort* antwort) {
+    const char* pfad = argc > 1 ? argv[1] : SPUREN_DATEI;
     
-    // Nur alle 30 Sekunden prüfen
-    if (jetzt - letzter_status_check < 30) {
+    if (!spuren_verfuegbar()) {
+        steuerung_antwort(antwort, "FEHLER: Spuren nicht einkompiliert (make spuren)\n");
+        return;
+    }
+    long anzahl = spuren_ausgeben(pfad);
+    if (anzahl < 0) {
+        steuerung_antwort(antwort, "FEHLER: %s konnte nicht geschrieben werden\n", pfad);
         return;
     }
+    steuerung_antwort(antwort, "%ld Spuren nach %s geschrieben\n", anzahl, pfad);
+}
+
+/**
+ * Kommando "ressourcen": Verlauf der Prozess-Ressourcen
+ */
+static void befehl_ressourcen(int argc, char* argv[], SteuerAntwort* antwort) {
+    RessourcenProbe verlauf[RESSOURCEN_VERLAUF];
+    int max_anzahl = argc > 1 ? atoi(argv[1]) : 10;
+    if (max_anzahl <= 0 || max_anzahl > RESSOURCEN_VERLAUF) {
+        max_anzahl = RESSOURCEN_VERLAUF;
+    }
     
+    int anzahl = ressourcen_verlauf(verlauf, max_anzahl);
+    steuerung_antwort(antwort, "%8s %8s %8s %5s %8s %6s %9s %9s %10s %10s\n", "alter_s", "rss_kib", "daten_kib",
+                      "fds", "cpu_s", "cpu_%", "freiwill", "verdraengt", "gelesen", "geschrieben");
+    long long jetzt_ms = anzahl > 0 ? verlauf[anzahl - 1].zeit_ms : 0;
+    for (int i = 0; i < anzahl; i++) {
+        const RessourcenProbe* p = &verlauf[i];
+        steuerung_antwort(antwort, "%8lld %8lu %8lu %5lu %8.2f %6.2f %9lu %9lu %10llu %10llu\n",
+                          (jetzt_ms - p->zeit_ms) / 1000, p->rss_kib, p->daten_kib, p->offene_fds,
+                          (double)p->cpu_us / 1e6, p->cpu_prozent, p->freiwillige_wechsel,
+                          p->unfreiwillige_wechsel, p->gelesen_bytes, p->geschrieben_bytes);
+    }
+}
+
+/**
+ * Registriert die Steuer-Kommandos der Hauptanwendung
+ */
+void steuer_befehle_registrieren(void) {
+    steuerung_befehl_registrieren("taster", "Simulierter Tastendruck (Log-Level weiterschalten)", befehl_taster);
+    steuerung_befehl_registrieren("stats", "Laufzeit-Statistik ausgeben", befehl_stats);
+    steuerung_befehl_registrieren("refresh", "Display-Ausgabe erzwingen", befehl_refresh);
+    steuerung_befehl_registrieren("snapshot", "Aktuellen Zustand ausgeben", befehl_snapshot);
+    steuerung_befehl_registrieren("flugschreiber", "flugschreiber [n|sichern] - Letzte Log-Einträge aller Level",
+                                  befehl_flugschreiber);
+    steuerung_befehl_registrieren("dauerhaftigkeit",
+                                  "dauerhaftigkeit [keine|batch|sync[:MS[:N]] [an|aus]] - Log-Sicherung",
+                                  befehl_dauerhaftigkeit);
+    steuerung_befehl_registrieren("lcd", "Inhalt und Bus-Zeiten des simulierten LCD", befehl_lcd);
+    steuerung_befehl_registrieren("zeitplan", "Periodische Aufträge der Hauptschleife", befehl_zeitplan);
+    steuerung_befehl_registrieren("latenz", "latenz [reset] - p50/p99/max von Start-Verspätung und Laufzeit",
+                                  befehl_latenz);
+    steuerung_befehl_registrieren("start", "Dauer der Startphasen bis zum ersten Messwert", befehl_start);
+    steuerung_befehl_registrieren("metriken", "Zähler, Messwerte und Histogramme im Prometheus-Textformat",
+                                  befehl_metriken);
+    steuerung_befehl_registrieren("spuren", "spuren [datei] - Zeitspuren als Chrome-Trace-JSON sichern",
+                                  befehl_spuren);
+    steuerung_befehl_registrieren("ressourcen", "ressourcen [n] - Letzte n Proben von RSS, Heap, FDs, CPU und I/O",
+                                  befehl_ressourcen);
+}
+
+/**
+ * Überprüft allgemeinen System-Status
+ */
+void system_status_pruefen(void) {
     LOG_DEBUG_MSG("System-Status wird geprüft");
     
-    // Speicher-Status prüfen (vereinfacht)
-    // In echter Implementierung würde hier malloc_stats() o.ä. verwendet
+    // Speicher, Deskriptoren und CPU-Last des Prozesses mit Trend-Erkennung
+    ressourcen_pruefen();
     
     // Datei-System prüfen
     if (access("Workspace", F_OK) != 0) {
@@ -232,7 +1148,7 @@ void system_status_pruefen(void) {
     }
     
     // Log-Datei-Größe prüfen
-    FILE* log_datei = fopen("kuehlschrank.log", "r");
+    FILE* log_datei = fopen(LOG_DATEI, "r");
     if (log_datei != NULL) {
         fseek(log_datei, 0, SEEK_END);
         long log_groesse = ftell(log_datei);
@@ -244,7 +1160,6 @@ void system_status_pruefen(void) {
         }
     }
     
-    letzter_status_check = jetzt;
     LOG_DEBUG_MSG("System-Status OK");
 }
 
@@ -254,18 +1169,49 @@ void system_status_pruefen(void) {
 void system_beenden(void) {
     LOG_INFO_MSG("System-Shutdown wird eingeleitet");
     
+    // Harte Frist: hängt das Herunterfahren (z.B. blockierendes fdatasync),
+    // beendet SIGALRM den Prozess über abschalt_notfall(). Ein weiteres
+    // SIGINT/SIGTERM bricht ebenso sofort ab.
+    uint64_t frist_us = latenz_jetzt_us() + (uint64_t)ABSCHALT_FRIST_MS * 1000;
+    struct sigaction notfall;
+    memset(&notfall, 0, sizeof(notfall));
+    notfall.sa_handler = abschalt_notfall;
+    sigfillset(&notfall.sa_mask);
+    sigaction(SIGALRM, &notfall, NULL);
+    sigaction(SIGINT, &notfall, NULL);
+    sigaction(SIGTERM, &notfall, NULL);
+    alarm((ABSCHALT_FRIST_MS + 999) / 1000);
+    if (signal_fd >= 0) {
+        sigset_t signale;
+        sigemptyset(&signale);
+        sigaddset(&signale, SIGINT);
+        sigaddset(&signale, SIGTERM);
+        sigprocmask(SIG_UNBLOCK, &signale, NULL);
+    }
+    
     if (system_initialisiert) {
-        // Display-Abschiedsmeldung
+        // Display-Abschiedsmeldung (bleibt nach Programmende stehen)
         display_beenden();
-        sleep(2);
         
         // Systeme herunterfahren
+        steuerung_beenden();
         sensor_system_beenden();
         logging_beenden();
+        flugschreiber_beenden();
+    }
+    
+    if (signal_fd >= 0) {
+        close(signal_fd);
+        signal_fd = -1;
     }
     
-    printf("\nSmart Kühlschrank Firmware beendet.\n");
-    printf("Auf Wiedersehen!\n");
+    konsole_printf("\nSmart Kühlschrank Firmware beendet.\n");
+    konsole_printf("Auf Wiedersehen!\n");
+    
+    // Konsole mit der verbleibenden Zeit leeren
+    uint64_t jetzt_us = latenz_jetzt_us();
+    konsole_beenden(jetzt_us < frist_us ? (int)((frist_us - jetzt_us) / 1000) : 0);
+    alarm(0);
 }
 
 /**
@@ -277,17 +1223,56 @@ void hilfe_anzeigen(void) {
     printf("Verwendung: %s [Optionen]\n\n", "smart_fridge");
     printf("Optionen:\n");
     printf("  -h, --help     Zeigt diese Hilfe an\n");
-    printf("  -v, --version  Zeigt Versionsinformationen an\n\n");
+    printf("  -v, --version  Zeigt Versionsinformationen an\n");
+    printf("  -c, --befehl CMD  Kommando an laufende Firmware senden\n");
+    printf("  --taster-datei Taster-Datei %s abfragen (Adapter)\n", BUTTON_FILE);
+    printf("  --schnellstart Erster Messwert vor Display und Steuer-Socket, ohne\n");
+    printf("                 Start-Einblendungen (z.B. mit --ausgabe datei nach Watchdog-Neustart)\n");
+    printf("  --ausgabe MODUS\n");
+    printf("                 datei, konsole, beide (Standard) oder keine\n");
+    printf("  --bildrate FPS Höchstens FPS Display-Ausgaben pro Sekunde\n");
+    printf("                 (Standard: %d, 0 = unbegrenzt)\n", DISPLAY_BILDRATE_STANDARD);
+    printf("  --simulation an|aus\n");
+    printf("                 Sensor-Dateien alle %d s mit Zufallswerten beschreiben\n", SENSOR_WRITE_INTERVAL);
+    printf("                 (Standard: an; aus, wenn ein anderer Prozess sie schreibt)\n");
+    printf("  --sensor-intervall MS\n");
+    printf("                 Sensor-Dateien alle MS ms prüfen (Standard: %d)\n", SENSOR_UPDATE_INTERVAL * 1000);
+    printf("  --terminal auto|an|aus\n");
+    printf("                 Display auf dem Terminal an Ort und Stelle aktualisieren\n");
+    printf("                 (Standard: auto, wenn stdout ein Terminal ist)\n");
+    printf("  --dauerhaftigkeit STUFE\n");
+    printf("                 Sicherung der Log-Datei: keine, batch (Standard) oder\n");
+    printf("                 sync[:MS[:N]] (fdatasync alle MS ms oder N Einträge)\n");
+    printf("  --fehler-sync an|aus\n");
+    printf("                 FEHLER-Einträge sofort synchronisieren (Standard: an)\n");
+    printf("  --i2c-takt HZ  Takt des simulierten Display-Busses (100000 oder 400000)\n");
+    printf("  --query [--from ZEIT] [--to ZEIT] [--level LEVEL] [--log DATEI]\n");
+    printf("                 Log-Einträge eines Zeitraums über den Zeit-Index abfragen\n");
+    printf("                 (ZEIT: 'JJJJ-MM-TT HH:MM[:SS]', LEVEL: DEBUG..FEHLER oder 0-3)\n");
+    printf("  --status [DATEI]\n");
+    printf("                 Status-Datensatz der laufenden Firmware ausgeben\n");
+    printf("  --flugschreiber [DATEI]\n");
+    printf("                 Flugschreiber-Datei ausgeben (auch nach Absturz)\n");
+    printf("  --log-kategorie KAT=LEVEL\n");
+    printf("                 Log-Level einer Kategorie setzen (sensor, display,\n");
+    printf("                 alarm, system, logging; Level 0-3), mehrfach möglich\n\n");
     printf("Steuerung während der Laufzeit:\n");
     printf("  Ctrl+C         Programm beenden\n");
-    printf("  echo '1' > %s  Log-Level erhöhen\n", BUTTON_FILE);
+    printf("  kill -HUP      Log-Datei neu öffnen (nach Rotation), Sensoren neu lesen\n");
+    printf("  kill -USR1     Laufzeit-Statistik ins Log schreiben\n");
+    printf("  kill -USR2     Flugschreiber nach %s sichern\n", FLUGSCHREIBER_DUMP_DATEI);
+    printf("  smart_fridge -c hilfe      Verfügbare Steuer-Kommandos\n");
+    printf("  smart_fridge -c taster     Log-Level erhöhen\n");
+    printf("  smart_fridge -c 'loglevel sensor 0'  Kategorie-Level setzen\n");
+    printf("  echo '1' > %s  Log-Level erhöhen (nur mit --taster-datei)\n", BUTTON_FILE);
     printf("\nSensor-Dateien (manuell editierbar):\n");
     printf("  %s  Temperatur in °C\n", TEMPERATURE_FILE);
     printf("  %s       Tür-Status (0=zu, 1=offen) und Zeitstempel\n", DOOR_FILE);
     printf("  %s     Energieverbrauch in Watt\n", ENERGY_FILE);
     printf("\nDisplay-Ausgabe:\n");
-    printf("  %s     Aktueller Display-Inhalt\n", DISPLAY_DATEI);
-    printf("  kuehlschrank.log        System-Log-Datei\n");
+    printf("  %s     Status-Datensatz (Display-Inhalt und Werte)\n", DISPLAY_DATEI);
+    printf("  %s        System-Log-Datei\n", LOG_DATEI);
+    printf("  %s    Zeit-Index der Log-Datei\n", LOG_INDEX_DATEI);
 }
 
 /**
@@ -307,11 +1292,139 @@ void version_anzeigen(void) {
     printf("  Display: %dx%d Zeichen\n", DISPLAY_ROWS, DISPLAY_COLS);
 }
 
+/**
+ * Callback: Flugschreiber-Zeile auf die Konsole ausgeben
+ */
+static void flugschreiber_zeile_drucken(const char* zeile, void* kontext) {
+    (void)kontext;
+    fputs(zeile, stdout);
+}
+
+/**
+ * Liest den Status-Datensatz einer laufenden Firmware und gibt ihn aus
+ */
+int status_anzeigen(const char* pfad) {
+    StatusDaten status;
+    if (!status_datei_lesen(pfad, &status)) {
+        printf("Status-Datei nicht lesbar oder inkonsistent: %s\n", pfad);
+        return 1;
+    }
+    
+    printf("Sequenz:     %u\n", status.sequenz);
+    printf("Zeitpunkt:   %ld\n", status.zeit);
+    printf("Zeile 1:     |%s|\n", status.zeile1);
+    printf("Zeile 2:     |%s|\n", status.zeile2);
+    if (status.daten_gueltig) {
+        printf("Temperatur:  %ld.%ld°C\n", status.temperatur_zehntel / 10,
+               (status.temperatur_zehntel < 0 ? -status.temperatur_zehntel : status.temperatur_zehntel) % 10);
+        printf("Tür:         %s\n", status.tuer_offen ? "offen" : "geschlossen");
+        printf("Energie:     %ldW\n", status.energie_watt);
+        printf("Log-Level:   %d\n", status.log_level);
+        printf("Alarme:      0x%02X\n", status.alarme);
+    } else {
+        printf("Noch keine Sensor-Daten angezeigt\n");
+    }
+    return 0;
+}
+
+/**
+ * Wandelt "an" oder "aus" in 1 bzw. 0 um
+ * @return 1 bei Erfolg, 0 bei anderem Text
+ */
+static int schalter_aus_string(const char* text, int* wert) {
+    if (strcmp(text, "an") == 0) {
+        *wert = 1;
+    } else if (strcmp(text, "aus") == 0) {
+        *wert = 0;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Verarbeitet eine Option der Form KAT=LEVEL
+ */
+int log_kategorie_option_verarbeiten(const char* option) {
+    const char* trenner = strchr(option, '=');
+    if (trenner == NULL || trenner[1] < '0' || trenner[1] > '3' || trenner[2] != '\0') {
+        return 0;
+    }
+    
+    char name[16];
+    size_t laenge = (size_t)(trenner - option);
+    if (laenge >= sizeof(name)) {
+        return 0;
+    }
+    memcpy(name, option, laenge);
+    name[laenge] = '\0';
+    
+    LogKategorie kategorie = log_kategorie_aus_string(name);
+    if (kategorie == LOG_KAT_ANZAHL) {
+        return 0;
+    }
+    
+    start_kategorie_level[kategorie] = trenner[1] - '0';
+    return 1;
+}
+
+/**
+ * Abfrage-Modus: --query [--from ZEIT] [--to ZEIT] [--level LEVEL] [--log DATEI]
+ */
+int log_abfrage_modus(int argc, char* argv[], int erstes_argument) {
+    LogAbfrage abfrage = { LOG_DATEI, LOG_INDEX_DATEI, 0, 0, -1 };
+    char index_pfad[256];
+    
+    for (int i = erstes_argument; i < argc; i++) {
+        if (i + 1 >= argc) {
+            printf("Option %s erwartet einen Wert\n", argv[i]);
+            return 1;
+        }
+        if (strcmp(argv[i], "--from") == 0) {
+            if (!log_abfrage_zeit_parsen(argv[++i], &abfrage.von)) {
+                printf("Ungültige Zeit: %s (erwartet JJJJ-MM-TT HH:MM[:SS])\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--to") == 0) {
+            if (!log_abfrage_zeit_parsen(argv[++i], &abfrage.bis)) {
+                printf("Ungültige Zeit: %s (erwartet JJJJ-MM-TT HH:MM[:SS])\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--level") == 0) {
+            abfrage.min_level = log_abfrage_level_parsen(argv[++i]);
+            if (abfrage.min_level < 0) {
+                printf("Ungültiges Level: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--log") == 0) {
+            abfrage.log_pfad = argv[++i];
+            snprintf(index_pfad, sizeof(index_pfad), "%s.idx", abfrage.log_pfad);
+            abfrage.index_pfad = index_pfad;
+        } else {
+            printf("Unbekannte Abfrage-Option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    
+    LogAbfrageErgebnis ergebnis;
+    if (!log_abfrage_ausfuehren(&abfrage, stdout, &ergebnis)) {
+        printf("Log-Datei nicht lesbar: %s\n", abfrage.log_pfad);
+        return 1;
+    }
+    
+    fprintf(stderr, "%ld Treffer, %lld Bytes ab Offset %lld gelesen, %.2f ms\n",
+            ergebnis.treffer, ergebnis.gelesene_bytes, ergebnis.start_offset, ergebnis.dauer_ms);
+    return 0;
+}
+
 /**
  * Hauptfunktion
  */
 int main(int argc, char* argv[]) {
+    programm_start_us = latenz_jetzt_us();
+    
     // Kommandozeilen-Argumente verarbeiten
+    log_dauerhaftigkeit_abfragen(&start_dauerhaftigkeit);
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
             hilfe_anzeigen();
@@ -319,6 +1432,73 @@ int main(int argc, char* argv[]) {
         } else if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--version") == 0) {
             version_anzeigen();
             return 0;
+        } else if ((strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--befehl") == 0) && i + 1 < argc) {
+            return steuerung_client(STEUER_SOCKET, argv[i + 1]);
+        } else if (strcmp(argv[i], "--query") == 0) {
+            return log_abfrage_modus(argc, argv, i + 1);
+        } else if (strcmp(argv[i], "--status") == 0) {
+            return status_anzeigen((i + 1 < argc) ? argv[i + 1] : DISPLAY_DATEI);
+        } else if (strcmp(argv[i], "--flugschreiber") == 0) {
+            const char* pfad = (i + 1 < argc) ? argv[i + 1] : FLUGSCHREIBER_DATEI;
+            if (flugschreiber_datei_ausgeben(pfad, 0, flugschreiber_zeile_drucken, NULL) < 0) {
+                printf("Flugschreiber-Datei nicht lesbar: %s\n", pfad);
+                return 1;
+            }
+            return 0;
+        } else if (strcmp(argv[i], "--ausgabe") == 0 && i + 1 < argc) {
+            if (!ausgabe_modus_aus_string(argv[++i], &start_ausgabe_modus)) {
+                printf("Ungültiger Ausgabe-Modus: %s (datei, konsole, beide, keine)\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--bildrate") == 0 && i + 1 < argc) {
+            start_bildrate = atoi(argv[++i]);
+            if (start_bildrate < 0 || start_bildrate > 1000) {
+                printf("Ungültige Bildrate: %s (0-1000)\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--simulation") == 0 && i + 1 < argc) {
+            if (!schalter_aus_string(argv[++i], &simulation_aktiv)) {
+                printf("Ungültige Simulation: %s (an, aus)\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--sensor-intervall") == 0 && i + 1 < argc) {
+            sensor_intervall_ms = atoi(argv[++i]);
+            if (sensor_intervall_ms < 1 || sensor_intervall_ms > 60000) {
+                printf("Ungültiges Sensor-Intervall: %s (1-60000 ms)\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--terminal") == 0 && i + 1 < argc) {
+            if (!terminal_modus_aus_string(argv[++i], &start_terminal_modus)) {
+                printf("Ungültiger Terminal-Modus: %s (auto, an, aus)\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--dauerhaftigkeit") == 0 && i + 1 < argc) {
+            if (!log_dauerhaftigkeit_aus_string(argv[++i], &start_dauerhaftigkeit)) {
+                printf("Ungültige Dauerhaftigkeit: %s (keine, batch, sync[:MS[:N]])\n", argv[i]);
+                return 1;
+            }
+            start_dauerhaftigkeit_gesetzt = 1;
+        } else if (strcmp(argv[i], "--fehler-sync") == 0 && i + 1 < argc) {
+            if (!schalter_aus_string(argv[++i], &start_dauerhaftigkeit.fehler_sofort)) {
+                printf("Ungültiger Wert für --fehler-sync: %s (an, aus)\n", argv[i]);
+                return 1;
+            }
+            start_dauerhaftigkeit_gesetzt = 1;
+        } else if (strcmp(argv[i], "--i2c-takt") == 0 && i + 1 < argc) {
+            start_i2c_takt = strtoul(argv[++i], NULL, 10);
+            if (start_i2c_takt != I2C_TAKT_STANDARD && start_i2c_takt != I2C_TAKT_FAST) {
+                printf("Ungültiger I2C-Takt: %s (100000, 400000)\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--taster-datei") == 0) {
+            taster_datei_aktiv = 1;
+        } else if (strcmp(argv[i], "--schnellstart") == 0) {
+            schnellstart = 1;
+        } else if (strcmp(argv[i], "--log-kategorie") == 0 && i + 1 < argc) {
+            if (!log_kategorie_option_verarbeiten(argv[++i])) {
+                printf("Ungültige Log-Kategorie: %s (erwartet KAT=LEVEL)\n", argv[i]);
+                return 1;
+            }
         } else {
             printf("Unbekannte Option: %s\n", argv[i]);
             printf("Verwenden Sie -h für Hilfe.\n");
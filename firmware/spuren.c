@@ -0,0 +1,100 @@
+// Für clock_gettime unter C99
+#define _POSIX_C_SOURCE 200809L
+
+#include "spuren.h"
+#include "latenz.h"
+#include <stdio.h>
+#include <time.h>
+
+#ifdef SPUREN
+
+SpurEintrag spuren_puffer[SPUREN_PUFFER];
+uint32_t spuren_schreibindex = 0;
+
+// Bezugspunkt: Zählerstand und monotone Zeit beim Initialisieren
+static uint64_t bezug_ticks = 0;
+static uint64_t bezug_us = 0;
+
+/**
+ * CLOCK_MONOTONIC in Nanosekunden (Ersatz ohne TSC)
+ */
+uint64_t spur_zeitstempel_monoton(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Merkt den Bezugspunkt für die Umrechnung
+ */
+void spuren_initialisieren(void) {
+    spuren_schreibindex = 0;
+    bezug_ticks = spur_zeitstempel();
+    bezug_us = latenz_jetzt_us();
+}
+
+/**
+ * Schreibt den Ringpuffer als Chrome-Trace-JSON
+ * Die Tickrate wird aus dem Abstand zwischen Initialisierung und Ausgabe
+ * bestimmt, so dass keine Kalibrierschleife beim Start nötig ist.
+ */
+long spuren_ausgeben(const char* pfad) {
+    uint64_t jetzt_ticks = spur_zeitstempel();
+    uint64_t jetzt_us = latenz_jetzt_us();
+    if (jetzt_us <= bezug_us || jetzt_ticks <= bezug_ticks) {
+        return -1;
+    }
+    double ticks_pro_us = (double)(jetzt_ticks - bezug_ticks) / (double)(jetzt_us - bezug_us);
+
+    FILE* datei = fopen(pfad, "w");
+    if (datei == NULL) {
+        return -1;
+    }
+
+    // Älteste Einträge zuerst; bei übergelaufenem Puffer ab dem Schreibindex
+    uint32_t ende = spuren_schreibindex;
+    uint32_t anfang = ende > SPUREN_PUFFER ? ende - SPUREN_PUFFER : 0;
+    long anzahl = 0;
+
+    fprintf(datei, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (uint32_t i = anfang; i != ende; i++) {
+        const SpurEintrag* e = &spuren_puffer[i & (SPUREN_PUFFER - 1)];
+        if (e->beginn < bezug_ticks || e->ende < e->beginn) {
+            continue;
+        }
+        fprintf(datei, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+                anzahl > 0 ? ",\n" : "", e->name,
+                (double)(e->beginn - bezug_ticks) / ticks_pro_us,
+                (double)(e->ende - e->beginn) / ticks_pro_us);
+        anzahl++;
+    }
+    fprintf(datei, "\n]}\n");
+
+    if (fclose(datei) != 0) {
+        return -1;
+    }
+    return anzahl;
+}
+
+/**
+ * Spuren einkompiliert
+ */
+int spuren_verfuegbar(void) {
+    return 1;
+}
+
+#else
+
+void spuren_initialisieren(void) {
+}
+
+long spuren_ausgeben(const char* pfad) {
+    (void)pfad;
+    return -1;
+}
+
+int spuren_verfuegbar(void) {
+    return 0;
+}
+
+#endif // SPUREN
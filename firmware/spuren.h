@@ -0,0 +1,82 @@
+#ifndef SPUREN_H
+#define SPUREN_H
+
+#include <stdint.h>
+
+// Zeitspuren der Hauptschleife im Chrome-Trace-Format
+// Nur mit -DSPUREN (make spuren) einkompiliert; sonst sind SPUR_START und
+// SPUR_ENDE leer. Eine Spur kostet zwei TSC-Lesevorgänge und einen Eintrag
+// in einen Ringpuffer; umgerechnet und formatiert wird erst beim Ausgeben.
+// Die Datei lässt sich in chrome://tracing oder Perfetto öffnen.
+
+#define SPUREN_PUFFER 8192              // Einträge im Ringpuffer (Zweierpotenz)
+#define SPUREN_DATEI "Workspace/spuren.json"
+
+#ifdef SPUREN
+
+// Aufgezeichnete Spur (Zeitpunkte in Zählerticks)
+typedef struct {
+    const char* name;               // Zeichenkette mit statischer Lebensdauer
+    uint64_t beginn;
+    uint64_t ende;
+} SpurEintrag;
+
+extern SpurEintrag spuren_puffer[SPUREN_PUFFER];
+extern uint32_t spuren_schreibindex;
+
+uint64_t spur_zeitstempel_monoton(void);
+
+/**
+ * Liest den Zeitstempelzähler (TSC auf x86, sonst CLOCK_MONOTONIC in ns)
+ */
+static inline uint64_t spur_zeitstempel(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    uint32_t unten, oben;
+    __asm__ __volatile__("rdtsc" : "=a"(unten), "=d"(oben));
+    return ((uint64_t)oben << 32) | unten;
+#else
+    return spur_zeitstempel_monoton();
+#endif
+}
+
+/**
+ * Legt eine abgeschlossene Spur im Ringpuffer ab (ältere werden überschrieben)
+ */
+static inline void spur_aufzeichnen(const char* name, uint64_t beginn, uint64_t ende) {
+    SpurEintrag* eintrag = &spuren_puffer[spuren_schreibindex++ & (SPUREN_PUFFER - 1)];
+    eintrag->name = name;
+    eintrag->beginn = beginn;
+    eintrag->ende = ende;
+}
+
+#define SPUR_START(variable) uint64_t variable = spur_zeitstempel()
+#define SPUR_ENDE(variable, name) spur_aufzeichnen((name), (variable), spur_zeitstempel())
+
+#else
+
+#define SPUR_START(variable) ((void)0)
+#define SPUR_ENDE(variable, name) ((void)0)
+
+#endif // SPUREN
+
+// Funktionsdeklarationen
+
+/**
+ * Merkt den Bezugspunkt für die Umrechnung der Zählerticks
+ */
+void spuren_initialisieren(void);
+
+/**
+ * Schreibt den Inhalt des Ringpuffers als Chrome-Trace-JSON
+ * @param pfad Ziel-Datei
+ * @return Anzahl geschriebener Spuren, -1 bei Fehler oder ohne -DSPUREN
+ */
+long spuren_ausgeben(const char* pfad);
+
+/**
+ * Prüft, ob die Spuren einkompiliert sind
+ * @return 1 mit -DSPUREN, sonst 0
+ */
+int spuren_verfuegbar(void);
+
+#endif // SPUREN_H
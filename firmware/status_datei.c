@@ -0,0 +1,131 @@
+// Für pread/pwrite unter C99
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+
+#define LOG_KATEGORIE LOG_KAT_DISPLAY
+
+#include "status_datei.h"
+#include "logging.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Versuche bis zu einem konsistenten Stand
+#define STATUS_LESE_VERSUCHE 10
+
+static const char STATUS_FORMAT[] =
+    "SFSTATUS1 seq=%010u\n"
+    "zeit=%010ld\n"
+    "zeile1=%.40s\n"
+    "zeile2=%.40s\n"
+    "daten=%d\n"
+    "temp=%+06ld\n"
+    "tuer=%d\n"
+    "energie=%06ld\n"
+    "level=%d\n"
+    "alarme=%02x\n"
+    "ende=%010u\n";
+
+static int status_fd = -1;
+static char status_pfad[256] = "";
+static unsigned int sequenz = 0;
+
+static long begrenzen(long wert, long minimum, long maximum);
+
+/**
+ * Schreibt einen Datensatz
+ */
+int status_datei_schreiben(const char* pfad, const StatusDaten* status) {
+    if (status_fd < 0 || strcmp(pfad, status_pfad) != 0) {
+        status_datei_schliessen();
+        status_fd = open(pfad, O_WRONLY | O_CREAT, 0644);
+        if (status_fd < 0) {
+            LOG_WARNING_F("Status-Datei %s nicht verfügbar: %s", pfad, strerror(errno));
+            return 0;
+        }
+        // Alte, längere Formate abschneiden
+        if (ftruncate(status_fd, STATUS_DATENSATZ_GROESSE) != 0) {
+            LOG_WARNING_F("Status-Datei %s: %s", pfad, strerror(errno));
+        }
+        strncpy(status_pfad, pfad, sizeof(status_pfad) - 1);
+        status_pfad[sizeof(status_pfad) - 1] = '\0';
+    }
+
+    // Feste Feldbreiten: Werte begrenzen statt das Format zu verschieben
+    sequenz++;
+    char datensatz[STATUS_DATENSATZ_GROESSE + 1];
+    int laenge = snprintf(datensatz, sizeof(datensatz), STATUS_FORMAT,
+                          sequenz,
+                          status->zeit < 0 ? 0L : status->zeit,
+                          status->zeile1,
+                          status->zeile2,
+                          status->daten_gueltig ? 1 : 0,
+                          begrenzen(status->temperatur_zehntel, -99999, 99999),
+                          status->tuer_offen ? 1 : 0,
+                          begrenzen(status->energie_watt, 0, 999999),
+                          (int)begrenzen(status->log_level, 0, 9),
+                          status->alarme & 0xFFu,
+                          sequenz);
+    if (laenge != STATUS_DATENSATZ_GROESSE) {
+        return 0;
+    }
+
+    // Ein einziger Schreibzugriff an Offset 0; Leser prüfen Anfangs- und End-Sequenz
+    return pwrite(status_fd, datensatz, STATUS_DATENSATZ_GROESSE, 0) == STATUS_DATENSATZ_GROESSE;
+}
+
+/**
+ * Liest einen vollständigen Datensatz
+ */
+int status_datei_lesen(const char* pfad, StatusDaten* status) {
+    int fd = open(pfad, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+
+    int erfolg = 0;
+    for (int versuch = 0; versuch < STATUS_LESE_VERSUCHE && !erfolg; versuch++) {
+        char datensatz[STATUS_DATENSATZ_GROESSE + 1];
+        if (pread(fd, datensatz, STATUS_DATENSATZ_GROESSE, 0) != STATUS_DATENSATZ_GROESSE) {
+            break;
+        }
+        datensatz[STATUS_DATENSATZ_GROESSE] = '\0';
+
+        unsigned int ende = 0;
+        memset(status, 0, sizeof(*status));
+        int felder = sscanf(datensatz,
+                            "SFSTATUS1 seq=%u\nzeit=%ld\nzeile1=%40c\nzeile2=%40c\n"
+                            "daten=%d\ntemp=%ld\ntuer=%d\nenergie=%ld\nlevel=%d\nalarme=%x\nende=%u",
+                            &status->sequenz, &status->zeit, status->zeile1, status->zeile2,
+                            &status->daten_gueltig, &status->temperatur_zehntel, &status->tuer_offen,
+                            &status->energie_watt, &status->log_level, &status->alarme, &ende);
+
+        // Halb geschriebener Stand: Sequenzen verschieden, erneut lesen
+        erfolg = (felder == 11 && ende == status->sequenz);
+    }
+
+    close(fd);
+    return erfolg;
+}
+
+/**
+ * Schließt die Status-Datei
+ */
+void status_datei_schliessen(void) {
+    if (status_fd >= 0) {
+        close(status_fd);
+        status_fd = -1;
+    }
+    status_pfad[0] = '\0';
+}
+
+/**
+ * Begrenzt einen Wert auf einen Bereich
+ */
+static long begrenzen(long wert, long minimum, long maximum) {
+    if (wert < minimum) return minimum;
+    if (wert > maximum) return maximum;
+    return wert;
+}
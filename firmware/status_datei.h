@@ -0,0 +1,67 @@
+#ifndef STATUS_DATEI_H
+#define STATUS_DATEI_H
+
+#include "config.h"
+#include <stddef.h>
+
+// Status-Schnappschuss für externe Überwachung
+// Ein Datensatz fester Größe mit festen Feldpositionen (Text), der per
+// pwrite() an Offset 0 eines offen gehaltenen Deskriptors ersetzt wird.
+// Die Sequenznummer steht am Anfang und am Ende; stimmen beide nach einem
+// pread() nicht überein, wurde ein halb geschriebener Stand gelesen.
+//
+// Aufbau (eine Zeile pro Feld, Breiten fest):
+//   SFSTATUS1 seq=0000000042
+//   zeit=1760780000
+//   zeile1=<40 Zeichen>
+//   zeile2=<40 Zeichen>
+//   daten=1                    Sensor-Werte vorhanden
+//   temp=+00037                Zehntel °C
+//   tuer=0
+//   energie=000138             Watt
+//   level=1
+//   alarme=00                  DISPLAY_ALARM_* Bits (hex)
+//   ende=0000000042
+
+// Inhalt eines Datensatzes
+typedef struct {
+    unsigned int sequenz;
+    long zeit;
+    char zeile1[DISPLAY_COLS + 1];
+    char zeile2[DISPLAY_COLS + 1];
+    int daten_gueltig;
+    long temperatur_zehntel;
+    int tuer_offen;
+    long energie_watt;
+    int log_level;
+    unsigned int alarme;
+} StatusDaten;
+
+// Größe des Datensatzes in Bytes
+#define STATUS_DATENSATZ_GROESSE 213
+
+// Funktionsdeklarationen
+
+/**
+ * Schreibt einen Datensatz (öffnet die Datei beim ersten Aufruf)
+ * Die Sequenznummer wird intern hochgezählt.
+ * @param pfad Pfad der Status-Datei
+ * @param status Inhalt (sequenz wird ignoriert)
+ * @return 1 bei Erfolg, 0 bei Fehler
+ */
+int status_datei_schreiben(const char* pfad, const StatusDaten* status);
+
+/**
+ * Liest einen vollständigen Datensatz (wiederholt bei halb geschriebenem Stand)
+ * @param pfad Pfad der Status-Datei
+ * @param status Ergebnis
+ * @return 1 bei Erfolg, 0 wenn kein konsistenter Stand gelesen werden konnte
+ */
+int status_datei_lesen(const char* pfad, StatusDaten* status);
+
+/**
+ * Schließt die Status-Datei
+ */
+void status_datei_schliessen(void);
+
+#endif // STATUS_DATEI_H
@@ -0,0 +1,471 @@
+// Für Socket-/poll-Funktionen unter C99
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+
+#include "steuerung.h"
+#include "logging.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+// Registrierte Kommandos
+typedef struct {
+    const char* name;
+    const char* hilfe;
+    SteuerBefehlFunktion funktion;
+} SteuerBefehl;
+
+static SteuerBefehl befehle[STEUER_MAX_BEFEHLE];
+static int anzahl_befehle = 0;
+static int steuer_fd = -1;                       // Lauschender Socket
+static char socket_pfad[108] = "";               // Für unlink() beim Beenden
+static char antwort_puffer[STEUER_ANTWORT_GROESSE];
+
+// Offene Anfrage: Lesezustand bis zum Zeilenende oder zur Frist
+typedef struct {
+    int fd;                                     // -1 = frei
+    long long frist_ms;
+    size_t gelesen;
+    char zeile[STEUER_ZEILEN_LAENGE];
+} SteuerVerbindung;
+
+static SteuerVerbindung verbindungen[STEUER_MAX_VERBINDUNGEN];
+
+// accept() scheitert an fehlenden Deskriptoren: der Socket bleibt lesbar und
+// würde poll() sofort wieder wecken, daher bis hierhin nicht überwachen
+static long long annahme_pause_bis_ms = 0;
+static int annahme_gestoert = 0;                 // Episode bereits gemeldet
+
+static void befehl_hilfe(int argc, char* argv[], SteuerAntwort* antwort);
+static void befehl_loglevel(int argc, char* argv[], SteuerAntwort* antwort);
+static void verbindung_lesen(SteuerVerbindung* verbindung, long long jetzt);
+static void verbindung_beantworten(SteuerVerbindung* verbindung);
+
+static long long monotone_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/**
+ * Öffnet den Steuer-Socket
+ */
+int steuerung_initialisieren(const char* pfad) {
+    static int standard_registriert = 0;
+    for (int i = 0; i < STEUER_MAX_VERBINDUNGEN; i++) {
+        verbindungen[i].fd = -1;
+    }
+    if (!standard_registriert) {
+        standard_registriert = 1;
+        steuerung_befehl_registrieren("hilfe", "Listet alle Kommandos", befehl_hilfe);
+        steuerung_befehl_registrieren("loglevel", "loglevel [kategorie] <0-3> - Log-Level setzen",
+                                      befehl_loglevel);
+    }
+
+    struct sockaddr_un adresse;
+    if (strlen(pfad) >= sizeof(adresse.sun_path)) {
+        LOG_ERROR_F("Socket-Pfad zu lang: %s", pfad);
+        return 0;
+    }
+
+    steuer_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (steuer_fd < 0) {
+        LOG_ERROR_F("Steuer-Socket konnte nicht erstellt werden: %s", strerror(errno));
+        return 0;
+    }
+
+    memset(&adresse, 0, sizeof(adresse));
+    adresse.sun_family = AF_UNIX;
+    strcpy(adresse.sun_path, pfad);
+
+    // Verwaiste Socket-Datei eines abgestürzten Laufs entfernen; andere
+    // Dateien unter dem Pfad bleiben unangetastet
+    struct stat info;
+    if (lstat(pfad, &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            LOG_ERROR_F("Steuer-Socket %s: Pfad existiert und ist kein Socket", pfad);
+            close(steuer_fd);
+            steuer_fd = -1;
+            return 0;
+        }
+        unlink(pfad);
+    }
+
+    // Nur der eigene Benutzer darf Kommandos senden (Socket-Datei 0600)
+    mode_t alte_maske = umask(077);
+    int gebunden = bind(steuer_fd, (struct sockaddr*)&adresse, sizeof(adresse));
+    umask(alte_maske);
+
+    if (gebunden != 0 || listen(steuer_fd, 4) != 0) {
+        LOG_ERROR_F("Steuer-Socket %s nicht verfügbar: %s", pfad, strerror(errno));
+        close(steuer_fd);
+        steuer_fd = -1;
+        return 0;
+    }
+
+    // Lauschender Socket darf die Hauptschleife nie blockieren
+    fcntl(steuer_fd, F_SETFL, fcntl(steuer_fd, F_GETFL) | O_NONBLOCK);
+    strcpy(socket_pfad, pfad);
+
+    LOG_INFO_F("Steuer-Socket bereit: %s", pfad);
+    return 1;
+}
+
+/**
+ * Registriert ein Kommando
+ */
+int steuerung_befehl_registrieren(const char* name, const char* hilfe, SteuerBefehlFunktion funktion) {
+    if (anzahl_befehle >= STEUER_MAX_BEFEHLE) {
+        LOG_ERROR_F("Kommando-Tabelle voll, '%s' nicht registriert", name);
+        return 0;
+    }
+
+    befehle[anzahl_befehle].name = name;
+    befehle[anzahl_befehle].hilfe = hilfe;
+    befehle[anzahl_befehle].funktion = funktion;
+    anzahl_befehle++;
+    return 1;
+}
+
+/**
+ * Gibt den Socket-Deskriptor zurück
+ */
+int steuerung_fd(void) {
+    return steuer_fd;
+}
+
+/**
+ * Trägt Socket und offene Anfragen für poll() ein
+ */
+int steuerung_poll_eintragen(struct pollfd* pfd, int max_anzahl) {
+    int anzahl = 0;
+    int frei = 0;
+    for (int i = 0; i < STEUER_MAX_VERBINDUNGEN && anzahl < max_anzahl; i++) {
+        if (verbindungen[i].fd < 0) {
+            frei = 1;
+            continue;
+        }
+        pfd[anzahl].fd = verbindungen[i].fd;
+        pfd[anzahl].events = POLLIN;
+        pfd[anzahl].revents = 0;
+        anzahl++;
+    }
+    // Ohne freien Platz oder Deskriptor bleiben neue Verbindungen im
+    // Backlog des Kernels
+    if (annahme_pause_bis_ms != 0 && monotone_ms() >= annahme_pause_bis_ms) {
+        annahme_pause_bis_ms = 0;
+    }
+    if (steuer_fd >= 0 && frei && annahme_pause_bis_ms == 0 && anzahl < max_anzahl) {
+        pfd[anzahl].fd = steuer_fd;
+        pfd[anzahl].events = POLLIN;
+        pfd[anzahl].revents = 0;
+        anzahl++;
+    }
+    return anzahl;
+}
+
+/**
+ * Zeit bis zur nächsten Frist einer offenen Anfrage
+ */
+int steuerung_wartezeit_ms(int maximum) {
+    long long jetzt = -1;
+    if (annahme_pause_bis_ms != 0) {
+        jetzt = monotone_ms();
+        long long rest = annahme_pause_bis_ms - jetzt;
+        if (rest < maximum) {
+            maximum = rest > 0 ? (int)rest : 0;
+        }
+    }
+    for (int i = 0; i < STEUER_MAX_VERBINDUNGEN; i++) {
+        if (verbindungen[i].fd < 0) {
+            continue;
+        }
+        if (jetzt < 0) {
+            jetzt = monotone_ms();
+        }
+        long long rest = verbindungen[i].frist_ms - jetzt;
+        if (rest < maximum) {
+            maximum = rest > 0 ? (int)rest : 0;
+        }
+    }
+    return maximum;
+}
+
+/**
+ * Nimmt Verbindungen an (höchstens so viele, wie Plätze frei sind) und
+ * bearbeitet die offenen Anfragen
+ */
+void steuerung_verarbeiten(void) {
+    if (steuer_fd < 0) {
+        return;
+    }
+
+    long long jetzt = monotone_ms();
+    for (int i = 0; i < STEUER_MAX_VERBINDUNGEN && jetzt >= annahme_pause_bis_ms; i++) {
+        if (verbindungen[i].fd >= 0) {
+            continue;
+        }
+        int client_fd = accept(steuer_fd, NULL, NULL);
+        if (client_fd < 0) {
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+                // Erst nach der Pause oder einer geschlossenen Verbindung erneut versuchen
+                if (!annahme_gestoert) {
+                    LOG_WARNING_F("Steuer-Socket: Verbindung nicht angenommen (%s), Pause %d ms",
+                                  strerror(errno), STEUER_ANNAHME_PAUSE_MS);
+                    annahme_gestoert = 1;
+                }
+                annahme_pause_bis_ms = jetzt + STEUER_ANNAHME_PAUSE_MS;
+            }
+            // EAGAIN: keine weiteren Verbindungen
+            break;
+        }
+        if (annahme_gestoert) {
+            LOG_INFO_MSG("Steuer-Socket nimmt wieder Verbindungen an");
+            annahme_gestoert = 0;
+        }
+        fcntl(client_fd, F_SETFL, fcntl(client_fd, F_GETFL) | O_NONBLOCK);
+        // Sendepuffer für eine vollständige Antwort, damit send() nie warten muss
+        int groesse = STEUER_ANTWORT_GROESSE * 2;
+        setsockopt(client_fd, SOL_SOCKET, SO_SNDBUF, &groesse, sizeof(groesse));
+        verbindungen[i].fd = client_fd;
+        verbindungen[i].frist_ms = jetzt + STEUER_ANFRAGE_FRIST_MS;
+        verbindungen[i].gelesen = 0;
+    }
+
+    for (int i = 0; i < STEUER_MAX_VERBINDUNGEN; i++) {
+        if (verbindungen[i].fd >= 0) {
+            verbindung_lesen(&verbindungen[i], jetzt);
+        }
+    }
+}
+
+/**
+ * Liest, was ohne Warten verfügbar ist; beantwortet vollständige Anfragen
+ * und schließt Anfragen nach Ablauf der Frist
+ */
+static void verbindung_lesen(SteuerVerbindung* verbindung, long long jetzt) {
+    int vollstaendig = 0;
+    while (verbindung->gelesen < sizeof(verbindung->zeile) - 1) {
+        ssize_t n = read(verbindung->fd, verbindung->zeile + verbindung->gelesen,
+                         sizeof(verbindung->zeile) - 1 - verbindung->gelesen);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        if (n <= 0) {
+            // Ende der Anfrage (Client hat nur geschrieben und geschlossen) oder Fehler
+            vollstaendig = 1;
+            break;
+        }
+        verbindung->gelesen += (size_t)n;
+        if (memchr(verbindung->zeile, '\n', verbindung->gelesen) != NULL) {
+            vollstaendig = 1;
+            break;
+        }
+    }
+    if (verbindung->gelesen == sizeof(verbindung->zeile) - 1) {
+        vollstaendig = 1;
+    }
+
+    if (vollstaendig) {
+        verbindung_beantworten(verbindung);
+    } else if (jetzt >= verbindung->frist_ms) {
+        LOG_WARNING_MSG("Steuer-Anfrage nach Fristablauf verworfen");
+        static const char meldung[] = "FEHLER: Zeitüberschreitung\n";
+        if (send(verbindung->fd, meldung, sizeof(meldung) - 1, MSG_NOSIGNAL) < 0) {
+            // Client bereits weg
+        }
+    } else {
+        return;
+    }
+
+    close(verbindung->fd);
+    verbindung->fd = -1;
+    // Ein Deskriptor ist wieder frei
+    annahme_pause_bis_ms = 0;
+}
+
+/**
+ * Führt eine vollständige Anfrage aus und sendet die Antwort
+ */
+static void verbindung_beantworten(SteuerVerbindung* verbindung) {
+    verbindung->zeile[verbindung->gelesen] = '\0';
+    char* ende = strpbrk(verbindung->zeile, "\r\n");
+    if (ende != NULL) {
+        *ende = '\0';
+    }
+
+    SteuerAntwort antwort = { antwort_puffer, sizeof(antwort_puffer), 0 };
+    antwort_puffer[0] = '\0';
+    steuerung_befehl_ausfuehren(verbindung->zeile, &antwort);
+
+    // Antwort senden, ohne zu warten; ein verschwundener Client darf kein
+    // SIGPIPE auslösen. Der Sendepuffer fasst eine ganze Antwort.
+    size_t gesendet = 0;
+    while (gesendet < antwort.laenge) {
+        ssize_t n = send(verbindung->fd, antwort.puffer + gesendet, antwort.laenge - gesendet, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                LOG_WARNING_F("Steuer-Antwort gekürzt (%zu von %zu Bytes)", gesendet, antwort.laenge);
+            }
+            break;
+        }
+        gesendet += (size_t)n;
+    }
+}
+
+/**
+ * Zerlegt eine Kommandozeile und ruft den passenden Handler auf
+ */
+void steuerung_befehl_ausfuehren(char* zeile, SteuerAntwort* antwort) {
+    char* argv[STEUER_MAX_ARGUMENTE];
+    int argc = 0;
+
+    for (char* wort = strtok(zeile, " \t"); wort != NULL && argc < STEUER_MAX_ARGUMENTE;
+         wort = strtok(NULL, " \t")) {
+        argv[argc++] = wort;
+    }
+
+    if (argc == 0) {
+        steuerung_antwort(antwort, "FEHLER: leeres Kommando\n");
+        return;
+    }
+
+    for (int i = 0; i < anzahl_befehle; i++) {
+        if (strcmp(befehle[i].name, argv[0]) == 0) {
+            LOG_DEBUG_F("Steuer-Kommando: %s", argv[0]);
+            befehle[i].funktion(argc, argv, antwort);
+            return;
+        }
+    }
+
+    steuerung_antwort(antwort, "FEHLER: unbekanntes Kommando '%s' (siehe 'hilfe')\n", argv[0]);
+}
+
+/**
+ * Hängt formatierten Text an eine Antwort an
+ */
+void steuerung_antwort(SteuerAntwort* antwort, const char* format, ...) {
+    if (antwort->laenge + 1 >= antwort->groesse) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(antwort->puffer + antwort->laenge, antwort->groesse - antwort->laenge, format, args);
+    va_end(args);
+
+    if (n > 0) {
+        antwort->laenge += (size_t)n;
+        if (antwort->laenge >= antwort->groesse) {
+            antwort->laenge = antwort->groesse - 1; // Gekürzt
+        }
+    }
+}
+
+/**
+ * Sendet ein Kommando an eine laufende Firmware
+ */
+int steuerung_client(const char* pfad, const char* befehl) {
+    struct sockaddr_un adresse;
+    memset(&adresse, 0, sizeof(adresse));
+    adresse.sun_family = AF_UNIX;
+    if (strlen(pfad) >= sizeof(adresse.sun_path)) {
+        fprintf(stderr, "Socket-Pfad zu lang: %s\n", pfad);
+        return 1;
+    }
+    strcpy(adresse.sun_path, pfad);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&adresse, sizeof(adresse)) != 0) {
+        fprintf(stderr, "Keine Verbindung zu %s: %s\n", pfad, strerror(errno));
+        if (fd >= 0) {
+            close(fd);
+        }
+        return 1;
+    }
+
+    if (write(fd, befehl, strlen(befehl)) < 0 || write(fd, "\n", 1) < 0) {
+        fprintf(stderr, "Kommando konnte nicht gesendet werden: %s\n", strerror(errno));
+        close(fd);
+        return 1;
+    }
+
+    char puffer[4096];
+    ssize_t n;
+    while ((n = read(fd, puffer, sizeof(puffer))) > 0) {
+        fwrite(puffer, 1, (size_t)n, stdout);
+    }
+
+    close(fd);
+    return 0;
+}
+
+/**
+ * Schließt den Steuer-Socket
+ */
+void steuerung_beenden(void) {
+    for (int i = 0; i < STEUER_MAX_VERBINDUNGEN; i++) {
+        if (verbindungen[i].fd >= 0) {
+            close(verbindungen[i].fd);
+            verbindungen[i].fd = -1;
+        }
+    }
+    if (steuer_fd >= 0) {
+        close(steuer_fd);
+        steuer_fd = -1;
+        unlink(socket_pfad);
+        LOG_INFO_MSG("Steuer-Socket geschlossen");
+    }
+}
+
+/**
+ * Kommando "hilfe": listet alle Kommandos
+ */
+static void befehl_hilfe(int argc, char* argv[], SteuerAntwort* antwort) {
+    (void)argc;
+    (void)argv;
+
+    for (int i = 0; i < anzahl_befehle; i++) {
+        steuerung_antwort(antwort, "%-12s %s\n", befehle[i].name, befehle[i].hilfe);
+    }
+}
+
+/**
+ * Kommando "loglevel": globales oder Kategorie-Level setzen/anzeigen
+ */
+static void befehl_loglevel(int argc, char* argv[], SteuerAntwort* antwort) {
+    if (argc == 2) {
+        int level = atoi(argv[1]);
+        if (argv[1][0] < '0' || argv[1][0] > '3' || argv[1][1] != '\0') {
+            steuerung_antwort(antwort, "FEHLER: Level muss 0-3 sein\n");
+            return;
+        }
+        log_level_setzen(level);
+    } else if (argc == 3) {
+        LogKategorie kategorie = log_kategorie_aus_string(argv[1]);
+        if (kategorie == LOG_KAT_ANZAHL || argv[2][0] < '0' || argv[2][0] > '3' || argv[2][1] != '\0') {
+            steuerung_antwort(antwort, "FEHLER: loglevel <kategorie> <0-3>\n");
+            return;
+        }
+        log_kategorie_level_setzen(kategorie, atoi(argv[2]));
+    } else if (argc != 1) {
+        steuerung_antwort(antwort, "FEHLER: loglevel [kategorie] <0-3>\n");
+        return;
+    }
+
+    // Aktuellen Stand ausgeben
+    steuerung_antwort(antwort, "global: %s\n", log_level_zu_string((LogLevel)log_level_abfragen()));
+    for (int kat = 0; kat < LOG_KAT_ANZAHL; kat++) {
+        steuerung_antwort(antwort, "%s: %s\n", log_kategorie_zu_string((LogKategorie)kat),
+                          log_level_zu_string((LogLevel)log_kategorie_level_abfragen((LogKategorie)kat)));
+    }
+}
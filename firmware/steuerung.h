@@ -0,0 +1,106 @@
+#ifndef STEUERUNG_H
+#define STEUERUNG_H
+
+#include "config.h"
+#include <poll.h>
+#include <stddef.h>
+
+// Steuer-Socket für Laufzeit-Kommandos
+// Lokaler UNIX-Domain-Socket, ein Kommando pro Verbindung, zeilenbasiert.
+// Verbindungen sind nicht-blockierend; die Hauptschleife wartet per poll()
+// auf den Socket und alle offenen Anfragen, nie auf einen einzelnen Client.
+
+// Puffer für die Antwort eines Kommandos
+typedef struct {
+    char* puffer;                   // Antwort-Text
+    size_t groesse;                 // Kapazität des Puffers
+    size_t laenge;                  // Bisher geschriebene Zeichen
+} SteuerAntwort;
+
+// Signatur eines Kommando-Handlers (argv[0] ist der Kommandoname)
+typedef void (*SteuerBefehlFunktion)(int argc, char* argv[], SteuerAntwort* antwort);
+
+// Funktionsdeklarationen
+
+/**
+ * Öffnet den Steuer-Socket und registriert die Standard-Kommandos
+ * @param pfad Pfad des UNIX-Sockets
+ * @return 1 bei Erfolg, 0 bei Fehler (Firmware läuft ohne Socket weiter)
+ */
+int steuerung_initialisieren(const char* pfad);
+
+/**
+ * Registriert ein Kommando
+ * @param name Kommandoname (erstes Wort der Anfrage)
+ * @param hilfe Einzeilige Beschreibung für "hilfe"
+ * @param funktion Handler des Kommandos
+ * @return 1 bei Erfolg, 0 wenn die Tabelle voll ist
+ */
+int steuerung_befehl_registrieren(const char* name, const char* hilfe, SteuerBefehlFunktion funktion);
+
+/**
+ * Gibt den Socket-Deskriptor für poll() in der Hauptschleife zurück
+ * @return Deskriptor oder -1 wenn der Socket nicht offen ist
+ */
+int steuerung_fd(void);
+
+/**
+ * Trägt den Socket und die offenen Anfragen für poll() ein
+ * Der lauschende Socket fehlt, solange alle Plätze belegt sind.
+ * @param pfd Ziel (mindestens STEUER_MAX_VERBINDUNGEN + 1 Einträge)
+ * @param max_anzahl Größe des Ziels
+ * @return Anzahl eingetragener Deskriptoren
+ */
+int steuerung_poll_eintragen(struct pollfd* pfd, int max_anzahl);
+
+/**
+ * Zeit bis zur nächsten Frist einer offenen Anfrage
+ * @param maximum Obergrenze in Millisekunden
+ * @return Wartezeit in Millisekunden (0 = sofort)
+ */
+int steuerung_wartezeit_ms(int maximum);
+
+/**
+ * Nimmt wartende Verbindungen an, liest verfügbare Daten und führt
+ * vollständige Anfragen aus. Blockiert nie; unvollständige Anfragen
+ * bleiben bis zu ihrer Frist offen.
+ */
+void steuerung_verarbeiten(void);
+
+/**
+ * Führt eine Kommandozeile direkt aus (ohne Socket)
+ * @param zeile Kommandozeile, wird beim Zerlegen verändert
+ * @param antwort Antwort-Puffer
+ */
+void steuerung_befehl_ausfuehren(char* zeile, SteuerAntwort* antwort);
+
+/**
+ * Hängt formatierten Text an eine Antwort an (wird bei Überlauf gekürzt)
+ * @param antwort Antwort-Puffer
+ * @param format Printf-ähnliches Format
+ */
+void steuerung_antwort(SteuerAntwort* antwort, const char* format, ...);
+
+/**
+ * Sendet ein Kommando an eine laufende Firmware und gibt die Antwort aus
+ * @param pfad Pfad des UNIX-Sockets
+ * @param befehl Kommandozeile
+ * @return 0 bei Erfolg, 1 bei Verbindungsfehler
+ */
+int steuerung_client(const char* pfad, const char* befehl);
+
+/**
+ * Schließt den Steuer-Socket und entfernt die Socket-Datei
+ */
+void steuerung_beenden(void);
+
+// Grenzen für Kommandos und Antworten
+#define STEUER_MAX_BEFEHLE 32
+#define STEUER_MAX_ARGUMENTE 8
+#define STEUER_ZEILEN_LAENGE 256
+#define STEUER_ANTWORT_GROESSE 16384
+#define STEUER_MAX_VERBINDUNGEN 4           // Gleichzeitig offene Anfragen
+#define STEUER_ANFRAGE_FRIST_MS 1000        // Gesamtfrist einer Anfrage ab accept()
+#define STEUER_ANNAHME_PAUSE_MS 1000        // Kein accept() nach EMFILE/ENFILE für diese Zeit
+
+#endif // STEUERUNG_H
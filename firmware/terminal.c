@@ -0,0 +1,267 @@
+// Für isatty unter C99
+#define _POSIX_C_SOURCE 200809L
+
+#include "terminal.h"
+#include "display.h"
+#include "konsole.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Bis zu dieser Lücke werden Bereiche einer Zeile zusammengefasst;
+// unveränderte Zeichen mitzuschicken ist billiger als eine neue
+// Cursor-Positionierung (ESC [ z ; s H, 6-7 Bytes)
+#define TERMINAL_LAUF_MAX_LUECKE 6
+
+// Puffer für eine Aktualisierung (vollständiger Rahmen passt sicher hinein)
+#define TERMINAL_PUFFER_GROESSE 1024
+
+// Rahmen der bisherigen Ausgabe (Fallback ohne Terminal)
+static const char RAHMEN_ALT_OBEN[] = "┌──────────────────────────────────────────┐\n";
+static const char RAHMEN_ALT_UNTEN[] = "└──────────────────────────────────────────┘\n";
+
+// Rahmen der ANSI-Darstellung, bündig mit DISPLAY_COLS
+static const char RAHMEN_OBEN[] = "┌────────────────────────────────────────┐";
+static const char RAHMEN_UNTEN[] = "└────────────────────────────────────────┘";
+static const char RAHMEN_SEITE[] = "│";
+
+static int aktiv = 0;                   // ANSI-Darstellung eingeschaltet
+static int bereich_gesetzt = 0;         // Scroll-Bereich unter dem Rahmen aktiv
+static int schatten_gueltig = 0;        // 0 = Terminal-Inhalt unbekannt
+static char schatten[DISPLAY_ROWS][DISPLAY_COLS];
+static TerminalStatistik statistik = {0};
+
+static size_t rahmen_alt_laenge(void);
+static void rahmen_alt_ausgeben(const char* const zeilen[DISPLAY_ROWS]);
+static void rahmen_zeichnen(const char* const zeilen[DISPLAY_ROWS]);
+static size_t anhaengen(char* puffer, size_t position, const char* text, size_t laenge);
+static size_t cursor_anhaengen(char* puffer, size_t position, int zeile, int spalte);
+
+/**
+ * Entscheidet über die Darstellungsart
+ */
+int terminal_initialisieren(TerminalModus modus) {
+    const char* term = getenv("TERM");
+    
+    aktiv = 0;
+    schatten_gueltig = 0;
+    if (ausgabe_modus & AUSGABE_KONSOLE) {
+        if (modus == TERMINAL_AN) {
+            aktiv = 1;
+        } else if (modus == TERMINAL_AUTO) {
+            aktiv = isatty(STDOUT_FILENO) && term != NULL && strcmp(term, "dumb") != 0;
+        }
+    }
+    return aktiv;
+}
+
+/**
+ * Wandelt einen Modus-Namen um
+ */
+int terminal_modus_aus_string(const char* text, TerminalModus* modus) {
+    if (strcmp(text, "auto") == 0) {
+        *modus = TERMINAL_AUTO;
+    } else if (strcmp(text, "an") == 0) {
+        *modus = TERMINAL_AN;
+    } else if (strcmp(text, "aus") == 0) {
+        *modus = TERMINAL_AUS;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Prüft, ob die ANSI-Darstellung aktiv ist
+ */
+int terminal_aktiv(void) {
+    return aktiv;
+}
+
+/**
+ * Bringt das Terminal auf den angegebenen Inhalt
+ */
+void terminal_aktualisieren(const char* const zeilen[DISPLAY_ROWS]) {
+    if (!(ausgabe_modus & AUSGABE_KONSOLE)) {
+        return;
+    }
+    
+    if (!aktiv) {
+        rahmen_alt_ausgeben(zeilen);
+        return;
+    }
+    
+    if (!schatten_gueltig) {
+        rahmen_zeichnen(zeilen);
+        return;
+    }
+    
+    DisplayLauf laeufe[DISPLAY_ROWS * DISPLAY_MAX_LAEUFE];
+    int anzahl = 0;
+    for (int z = 0; z < DISPLAY_ROWS; z++) {
+        int neu = display_laeufe_berechnen(schatten[z], zeilen[z], z,
+                                           laeufe + anzahl, DISPLAY_MAX_LAEUFE);
+        
+        // Nahe Bereiche derselben Zeile zusammenfassen
+        int ziel = anzahl;
+        for (int i = anzahl; i < anzahl + neu; i++) {
+            if (ziel > anzahl) {
+                DisplayLauf* vorher = &laeufe[ziel - 1];
+                int luecke = laeufe[i].spalte - (vorher->spalte + vorher->laenge);
+                if (luecke <= TERMINAL_LAUF_MAX_LUECKE) {
+                    vorher->laenge = laeufe[i].spalte + laeufe[i].laenge - vorher->spalte;
+                    continue;
+                }
+            }
+            laeufe[ziel++] = laeufe[i];
+        }
+        anzahl = ziel;
+    }
+    
+    if (anzahl == 0) {
+        return;
+    }
+    
+    // Cursor sichern, Bereiche überschreiben, Cursor zurück in den Log-Bereich
+    char puffer[TERMINAL_PUFFER_GROESSE];
+    size_t laenge = anhaengen(puffer, 0, "\0337", 2);
+    for (int i = 0; i < anzahl; i++) {
+        const DisplayLauf* lauf = &laeufe[i];
+        laenge = cursor_anhaengen(puffer, laenge, lauf->zeile + 2, lauf->spalte + 2);
+        laenge = anhaengen(puffer, laenge, zeilen[lauf->zeile] + lauf->spalte, (size_t)lauf->laenge);
+    }
+    laenge = anhaengen(puffer, laenge, "\0338", 2);
+    
+    statistik.aktualisierungen++;
+    statistik.bytes_rahmen += rahmen_alt_laenge();
+    if (!konsole_schreiben(puffer, laenge)) {
+        // Verworfen: Terminal-Inhalt unbekannt, nächstes Mal vollständig
+        schatten_gueltig = 0;
+        return;
+    }
+    statistik.bytes += laenge;
+    for (int i = 0; i < anzahl; i++) {
+        memcpy(&schatten[laeufe[i].zeile][laeufe[i].spalte],
+               zeilen[laeufe[i].zeile] + laeufe[i].spalte, (size_t)laeufe[i].laenge);
+    }
+}
+
+/**
+ * Zeichnet den Rahmen bei der nächsten Aktualisierung vollständig neu
+ */
+void terminal_neu_zeichnen(void) {
+    schatten_gueltig = 0;
+}
+
+/**
+ * Liefert die Zähler der Terminal-Darstellung
+ */
+void terminal_statistik_abfragen(TerminalStatistik* ziel) {
+    *ziel = statistik;
+}
+
+/**
+ * Hebt den Scroll-Bereich auf
+ */
+void terminal_beenden(void) {
+    if (bereich_gesetzt) {
+        // DECSTBM setzt den Cursor nach oben; Position im Log-Bereich behalten
+        konsole_schreiben("\0337\033[r\0338", 7);
+        bereich_gesetzt = 0;
+    }
+    aktiv = 0;
+}
+
+/**
+ * Länge des bisherigen, vollständigen Rahmens
+ */
+static size_t rahmen_alt_laenge(void) {
+    return 1 + (sizeof(RAHMEN_ALT_OBEN) - 1) + (sizeof(RAHMEN_ALT_UNTEN) - 1)
+         + DISPLAY_ROWS * (2 * (sizeof(RAHMEN_SEITE) - 1) + DISPLAY_COLS + 1);
+}
+
+/**
+ * Gibt den vollständigen Rahmen als neuen Block aus (kein Terminal)
+ */
+static void rahmen_alt_ausgeben(const char* const zeilen[DISPLAY_ROWS]) {
+    char puffer[TERMINAL_PUFFER_GROESSE];
+    size_t laenge = anhaengen(puffer, 0, "\n", 1);
+    laenge = anhaengen(puffer, laenge, RAHMEN_ALT_OBEN, sizeof(RAHMEN_ALT_OBEN) - 1);
+    for (int z = 0; z < DISPLAY_ROWS; z++) {
+        laenge = anhaengen(puffer, laenge, RAHMEN_SEITE, sizeof(RAHMEN_SEITE) - 1);
+        laenge = anhaengen(puffer, laenge, zeilen[z], DISPLAY_COLS);
+        laenge = anhaengen(puffer, laenge, RAHMEN_SEITE, sizeof(RAHMEN_SEITE) - 1);
+        laenge = anhaengen(puffer, laenge, "\n", 1);
+    }
+    laenge = anhaengen(puffer, laenge, RAHMEN_ALT_UNTEN, sizeof(RAHMEN_ALT_UNTEN) - 1);
+    
+    // Als ein Block an die Konsolen-Senke geben
+    statistik.aktualisierungen++;
+    statistik.bytes_rahmen += laenge;
+    if (konsole_schreiben(puffer, laenge)) {
+        statistik.bytes += laenge;
+    }
+}
+
+/**
+ * Zeichnet den Rahmen in den obersten Zeilen vollständig
+ */
+static void rahmen_zeichnen(const char* const zeilen[DISPLAY_ROWS]) {
+    char puffer[TERMINAL_PUFFER_GROESSE];
+    size_t laenge = 0;
+    
+    if (!bereich_gesetzt) {
+        // Erstes Zeichnen: Bildschirm leeren, Log-Zeilen unter dem Rahmen scrollen
+        char bereich[32];
+        int n = snprintf(bereich, sizeof(bereich), "\033[H\033[2J\033[%dr", TERMINAL_RAHMEN_ZEILEN + 1);
+        laenge = anhaengen(puffer, laenge, bereich, (size_t)n);
+        laenge = cursor_anhaengen(puffer, laenge, TERMINAL_RAHMEN_ZEILEN + 1, 1);
+    }
+    
+    laenge = anhaengen(puffer, laenge, "\0337", 2);
+    laenge = cursor_anhaengen(puffer, laenge, 1, 1);
+    laenge = anhaengen(puffer, laenge, RAHMEN_OBEN, sizeof(RAHMEN_OBEN) - 1);
+    for (int z = 0; z < DISPLAY_ROWS; z++) {
+        laenge = cursor_anhaengen(puffer, laenge, z + 2, 1);
+        laenge = anhaengen(puffer, laenge, RAHMEN_SEITE, sizeof(RAHMEN_SEITE) - 1);
+        laenge = anhaengen(puffer, laenge, zeilen[z], DISPLAY_COLS);
+        laenge = anhaengen(puffer, laenge, RAHMEN_SEITE, sizeof(RAHMEN_SEITE) - 1);
+    }
+    laenge = cursor_anhaengen(puffer, laenge, DISPLAY_ROWS + 2, 1);
+    laenge = anhaengen(puffer, laenge, RAHMEN_UNTEN, sizeof(RAHMEN_UNTEN) - 1);
+    laenge = anhaengen(puffer, laenge, "\0338", 2);
+    
+    statistik.aktualisierungen++;
+    statistik.neuzeichnungen++;
+    statistik.bytes_rahmen += rahmen_alt_laenge();
+    if (!konsole_schreiben(puffer, laenge)) {
+        return;
+    }
+    statistik.bytes += laenge;
+    bereich_gesetzt = 1;
+    for (int z = 0; z < DISPLAY_ROWS; z++) {
+        memcpy(schatten[z], zeilen[z], DISPLAY_COLS);
+    }
+    schatten_gueltig = 1;
+}
+
+/**
+ * Hängt Bytes an den Ausgabepuffer an (kürzt am Pufferende)
+ */
+static size_t anhaengen(char* puffer, size_t position, const char* text, size_t laenge) {
+    if (position + laenge > TERMINAL_PUFFER_GROESSE) {
+        laenge = TERMINAL_PUFFER_GROESSE - position;
+    }
+    memcpy(puffer + position, text, laenge);
+    return position + laenge;
+}
+
+/**
+ * Hängt eine Cursor-Positionierung an (1-basiert)
+ */
+static size_t cursor_anhaengen(char* puffer, size_t position, int zeile, int spalte) {
+    char folge[16];
+    int n = snprintf(folge, sizeof(folge), "\033[%d;%dH", zeile, spalte);
+    return anhaengen(puffer, position, folge, (size_t)n);
+}
@@ -0,0 +1,76 @@
+#ifndef TERMINAL_H
+#define TERMINAL_H
+
+#include "config.h"
+
+// Display-Darstellung auf einem ANSI-Terminal
+// Der Rahmen steht fest in den obersten Zeilen; Log-Zeilen laufen in einem
+// Scroll-Bereich darunter. Pro Aktualisierung werden nur geänderte Zeichen
+// per Cursor-Positionierung überschrieben statt den Rahmen neu auszugeben.
+
+// Darstellungsart
+typedef enum {
+    TERMINAL_AUTO = 0,              // ANSI, wenn stdout ein Terminal ist
+    TERMINAL_AN,                    // Immer ANSI (z.B. für Messungen über Pipes)
+    TERMINAL_AUS                    // Immer den vollständigen Rahmen ausgeben
+} TerminalModus;
+
+// Zähler der Terminal-Darstellung
+typedef struct {
+    unsigned long aktualisierungen;     // Ausgegebene Änderungen
+    unsigned long neuzeichnungen;       // Vollständig gezeichnete Rahmen
+    unsigned long bytes;                // Tatsächlich übergebene Bytes
+    unsigned long bytes_rahmen;         // Bytes bei vollständigem Rahmen je Änderung
+} TerminalStatistik;
+
+// Zeilen, die Rahmen und Display oben belegen
+#define TERMINAL_RAHMEN_ZEILEN (DISPLAY_ROWS + 2)
+
+// Funktionsdeklarationen
+
+/**
+ * Entscheidet über die Darstellungsart
+ * @param modus Gewünschter Modus
+ * @return 1 wenn die ANSI-Darstellung aktiv ist, 0 für den Rahmen-Fallback
+ */
+int terminal_initialisieren(TerminalModus modus);
+
+/**
+ * Wandelt "auto", "an" oder "aus" in einen Modus um
+ * @param text Name des Modus
+ * @param modus Ergebnis
+ * @return 1 bei Erfolg, 0 bei unbekanntem Namen
+ */
+int terminal_modus_aus_string(const char* text, TerminalModus* modus);
+
+/**
+ * Prüft, ob die ANSI-Darstellung aktiv ist
+ * @return 1 wenn aktiv
+ */
+int terminal_aktiv(void);
+
+/**
+ * Bringt das Terminal auf den angegebenen Inhalt
+ * Beim ersten Aufruf (oder nach verworfener Ausgabe) wird der Rahmen
+ * vollständig gezeichnet, danach nur geänderte Bereiche.
+ * @param zeilen Soll-Inhalt, DISPLAY_ROWS Zeilen mit je DISPLAY_COLS Zeichen
+ */
+void terminal_aktualisieren(const char* const zeilen[DISPLAY_ROWS]);
+
+/**
+ * Zeichnet den Rahmen bei der nächsten Aktualisierung vollständig neu
+ */
+void terminal_neu_zeichnen(void);
+
+/**
+ * Liefert die Zähler der Terminal-Darstellung
+ * @param statistik Ziel-Struktur
+ */
+void terminal_statistik_abfragen(TerminalStatistik* statistik);
+
+/**
+ * Hebt den Scroll-Bereich auf und setzt den Cursor unter den Rahmen
+ */
+void terminal_beenden(void);
+
+#endif // TERMINAL_H
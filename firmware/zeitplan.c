@@ -0,0 +1,284 @@
+// Für clock_gettime unter C99
+#define _POSIX_C_SOURCE 200809L
+
+#include "zeitplan.h"
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+#define FACH_MASKE (ZEITPLAN_FAECHER - 1)
+
+// Größte Entfernung, die das Zeitrad abbilden kann
+#define MAX_ABSTAND_TICKS ((1ULL << (ZEITPLAN_EBENEN * ZEITPLAN_FACH_BITS)) - 1)
+
+static ZeitplanAuftrag* rad[ZEITPLAN_EBENEN][ZEITPLAN_FAECHER];
+static uint64_t aktueller_tick = 0;     // Nächster abzuarbeitender Tick
+static long long start_ms = 0;
+static ZeitplanStatistik statistik = {0};
+
+static long long monotone_ms(void);
+static uint64_t tick_von_ms(long long ms);
+static void fach_einhaengen(ZeitplanAuftrag* auftrag);
+static void fach_aushaengen(ZeitplanAuftrag* auftrag);
+static void ablauf_berechnen(ZeitplanAuftrag* auftrag);
+static int ebene_umsortieren(int ebene);
+
+/**
+ * Setzt den Zeitplaner zurück
+ */
+void zeitplan_initialisieren(void) {
+    memset(rad, 0, sizeof(rad));
+    memset(&statistik, 0, sizeof(statistik));
+    start_ms = monotone_ms();
+    aktueller_tick = 0;
+}
+
+/**
+ * Plant einen periodischen Auftrag ein
+ */
+void zeitplan_einplanen(ZeitplanAuftrag* auftrag, const char* name,
+                        int erster_ms, int intervall_ms, int toleranz_ms,
+                        ZeitplanFunktion funktion, void* kontext) {
+    memset(auftrag, 0, sizeof(*auftrag));
+    auftrag->name = name;
+    auftrag->funktion = funktion;
+    auftrag->kontext = kontext;
+    auftrag->intervall_ms = intervall_ms > 0 ? intervall_ms : ZEITPLAN_TICK_MS;
+    auftrag->toleranz_ms = toleranz_ms > 0 ? toleranz_ms : 0;
+    auftrag->frist_ms = monotone_ms() - start_ms + (erster_ms > 0 ? erster_ms : 0);
+
+    ablauf_berechnen(auftrag);
+    fach_einhaengen(auftrag);
+}
+
+/**
+ * Nimmt einen Auftrag aus dem Zeitrad
+ */
+void zeitplan_entfernen(ZeitplanAuftrag* auftrag) {
+    if (auftrag->vorgaenger != NULL) {
+        fach_aushaengen(auftrag);
+    }
+}
+
+/**
+ * Führt alle fälligen Aufträge aus
+ */
+int zeitplan_abarbeiten(void) {
+    long long jetzt = monotone_ms() - start_ms;
+    long long start_us = start_ms * 1000;
+    uint64_t ziel = tick_von_ms(jetzt);
+    int ausgefuehrt = 0;
+
+    while (aktueller_tick <= ziel) {
+        int fach = (int)(aktueller_tick & FACH_MASKE);
+
+        // Ebene 0 läuft über: nächstes Fach der höheren Ebenen verteilen
+        if (fach == 0) {
+            for (int ebene = 1; ebene < ZEITPLAN_EBENEN && ebene_umsortieren(ebene) == 0; ebene++) {
+            }
+        }
+
+        // Fach vollständig abhängen; Aufträge werden einzeln neu eingeplant.
+        // Während der Ausführung eingeplante, sofort fällige Aufträge landen
+        // wieder in diesem Fach und laufen noch im selben Tick.
+        ZeitplanAuftrag* liste;
+        while ((liste = rad[0][fach]) != NULL) {
+            rad[0][fach] = NULL;
+            liste->vorgaenger = &liste;
+
+            while (liste != NULL) {
+                ZeitplanAuftrag* auftrag = liste;
+                fach_aushaengen(auftrag);
+
+                // Verspätung gegenüber der Soll-Frist; erlaubt sind Toleranz
+                // (Rundung aufs Raster) und ein Tick (Auflösung des Zeitrads)
+                long long beginn_us = (long long)latenz_jetzt_us() - start_us;
+                long long verspaetung_us = beginn_us - auftrag->frist_ms * 1000;
+                latenz_erfassen(&auftrag->verspaetung, verspaetung_us > 0 ? (uint64_t)verspaetung_us : 0);
+                if (verspaetung_us > (long long)(auftrag->toleranz_ms + ZEITPLAN_TICK_MS) * 1000) {
+                    auftrag->fristverletzungen++;
+                    statistik.fristverletzungen++;
+                }
+
+                // Nächste Frist im festen Raster; hing die Schleife länger als ein
+                // Intervall, werden verpasste Ausführungen nicht nachgeholt
+                auftrag->frist_ms += auftrag->intervall_ms;
+                if (auftrag->frist_ms <= jetzt) {
+                    long long rueckstand = jetzt - auftrag->frist_ms;
+                    long long uebersprungen = rueckstand / auftrag->intervall_ms + 1;
+                    auftrag->verpasst += (unsigned long)uebersprungen;
+                    auftrag->frist_ms += uebersprungen * auftrag->intervall_ms;
+                }
+                ablauf_berechnen(auftrag);
+
+                // Vor dem Aufruf einhängen: der Auftrag darf sich selbst entfernen
+                fach_einhaengen(auftrag);
+                auftrag->ausfuehrungen++;
+                statistik.ausfuehrungen++;
+                ausgefuehrt++;
+                auftrag->funktion(auftrag->kontext);
+                latenz_erfassen(&auftrag->laufzeit, (uint64_t)((long long)latenz_jetzt_us() - start_us - beginn_us));
+            }
+        }
+
+        aktueller_tick++;
+        statistik.ticks++;
+    }
+
+    return ausgefuehrt;
+}
+
+/**
+ * Zeit bis zum nächsten möglichen Ablauf
+ */
+int zeitplan_wartezeit_ms(int maximum) {
+    uint64_t naechster = UINT64_MAX;
+
+    // Ebene 0: genaues Fach
+    for (int i = 0; i < ZEITPLAN_FAECHER; i++) {
+        if (rad[0][(aktueller_tick + (uint64_t)i) & FACH_MASKE] != NULL) {
+            naechster = aktueller_tick + (uint64_t)i;
+            break;
+        }
+    }
+
+    // Höhere Ebenen: Zeitpunkt des Umsortierens als untere Schranke
+    // (kann vor dem nächsten Fach der Ebene 0 liegen)
+    for (int ebene = 1; ebene < ZEITPLAN_EBENEN; ebene++) {
+        int verschiebung = ebene * ZEITPLAN_FACH_BITS;
+        uint64_t position = aktueller_tick >> verschiebung;
+        for (int i = 1; i <= ZEITPLAN_FAECHER; i++) {
+            if (rad[ebene][(position + (uint64_t)i) & FACH_MASKE] != NULL) {
+                uint64_t umsortieren = (position + (uint64_t)i) << verschiebung;
+                if (umsortieren < naechster) {
+                    naechster = umsortieren;
+                }
+                break;
+            }
+        }
+    }
+
+    if (naechster == UINT64_MAX) {
+        return maximum;
+    }
+
+    long long warten = (long long)naechster * ZEITPLAN_TICK_MS - (monotone_ms() - start_ms);
+    if (warten <= 0) {
+        return 0;
+    }
+    return warten < maximum ? (int)warten : maximum;
+}
+
+/**
+ * Setzt die Latenz-Histogramme eines Auftrags zurück
+ */
+void zeitplan_latenz_zuruecksetzen(ZeitplanAuftrag* auftrag) {
+    latenz_zuruecksetzen(&auftrag->verspaetung);
+    latenz_zuruecksetzen(&auftrag->laufzeit);
+    auftrag->fristverletzungen = 0;
+}
+
+/**
+ * Liefert die Zähler des Zeitplaners
+ */
+void zeitplan_statistik_abfragen(ZeitplanStatistik* ziel) {
+    *ziel = statistik;
+}
+
+/**
+ * Monotone Zeit in Millisekunden
+ */
+static long long monotone_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/**
+ * Tick, in dem ein Zeitpunkt liegt
+ */
+static uint64_t tick_von_ms(long long ms) {
+    return ms > 0 ? (uint64_t)(ms / ZEITPLAN_TICK_MS) : 0;
+}
+
+/**
+ * Rundet die Frist im Rahmen der Toleranz auf ein grobes Raster
+ * Das Raster ist die größte Zweierpotenz an Ticks innerhalb der Toleranz;
+ * Aufträge mit ähnlicher Toleranz laufen so auf gemeinsamen Ticks.
+ */
+static void ablauf_berechnen(ZeitplanAuftrag* auftrag) {
+    uint64_t tick = tick_von_ms(auftrag->frist_ms + ZEITPLAN_TICK_MS - 1);
+    uint64_t toleranz_ticks = (uint64_t)auftrag->toleranz_ms / ZEITPLAN_TICK_MS;
+    uint64_t raster = 1;
+
+    while (raster * 2 <= toleranz_ticks) {
+        raster *= 2;
+    }
+    auftrag->ablauf_tick = (tick + raster - 1) & ~(raster - 1);
+}
+
+/**
+ * Hängt einen Auftrag in das Fach seines Ablaufs
+ */
+static void fach_einhaengen(ZeitplanAuftrag* auftrag) {
+    uint64_t ablauf = auftrag->ablauf_tick;
+
+    // Bereits fällig: im aktuellen Fach, läuft beim nächsten Abarbeiten
+    if (ablauf < aktueller_tick) {
+        ablauf = aktueller_tick;
+    }
+    if (ablauf - aktueller_tick > MAX_ABSTAND_TICKS) {
+        ablauf = aktueller_tick + MAX_ABSTAND_TICKS;
+    }
+
+    // Ebene nach Abstand: Ebene n nimmt Abstände < 64^(n+1) Ticks auf
+    uint64_t abstand = ablauf - aktueller_tick;
+    int ebene = 0;
+    while (ebene < ZEITPLAN_EBENEN - 1 &&
+           abstand >= (1ULL << ((ebene + 1) * ZEITPLAN_FACH_BITS))) {
+        ebene++;
+    }
+
+    ZeitplanAuftrag** kopf = &rad[ebene][(ablauf >> (ebene * ZEITPLAN_FACH_BITS)) & FACH_MASKE];
+    auftrag->ablauf_tick = ablauf;
+    auftrag->naechster = *kopf;
+    auftrag->vorgaenger = kopf;
+    if (*kopf != NULL) {
+        (*kopf)->vorgaenger = &auftrag->naechster;
+    }
+    *kopf = auftrag;
+    statistik.eingeplant++;
+}
+
+/**
+ * Hängt einen Auftrag aus seiner Liste
+ */
+static void fach_aushaengen(ZeitplanAuftrag* auftrag) {
+    *auftrag->vorgaenger = auftrag->naechster;
+    if (auftrag->naechster != NULL) {
+        auftrag->naechster->vorgaenger = auftrag->vorgaenger;
+    }
+    auftrag->naechster = NULL;
+    auftrag->vorgaenger = NULL;
+}
+
+/**
+ * Verteilt das aktuelle Fach einer höheren Ebene auf die darunterliegenden
+ * @return Index des verteilten Fachs (0 = auch die nächste Ebene verteilen)
+ */
+static int ebene_umsortieren(int ebene) {
+    int fach = (int)((aktueller_tick >> (ebene * ZEITPLAN_FACH_BITS)) & FACH_MASKE);
+    ZeitplanAuftrag* liste = rad[ebene][fach];
+    rad[ebene][fach] = NULL;
+    if (liste != NULL) {
+        liste->vorgaenger = &liste;
+    }
+
+    while (liste != NULL) {
+        ZeitplanAuftrag* auftrag = liste;
+        fach_aushaengen(auftrag);
+        fach_einhaengen(auftrag);
+        statistik.umsortiert++;
+    }
+    return fach;
+}
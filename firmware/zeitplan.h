@@ -0,0 +1,108 @@
+#ifndef ZEITPLAN_H
+#define ZEITPLAN_H
+
+#include <stdint.h>
+#include "latenz.h"
+
+// Zeitplaner für periodische Aufträge der Hauptschleife
+// Hierarchisches Zeitrad: 4 Ebenen mit je 64 Fächern, Ebene 0 in Ticks,
+// jede weitere 64-mal gröber. Einplanen und Ablauf sind O(1); Aufträge
+// höherer Ebenen wandern beim Überlauf der darunterliegenden Ebene nach
+// unten. Die Toleranz eines Auftrags rundet seinen Ablauf auf ein gröberes
+// Raster, damit Aufträge mit ähnlichem Takt im selben Aufwachen laufen.
+
+// Auszuführende Funktion eines Auftrags
+typedef void (*ZeitplanFunktion)(void* kontext);
+
+// Periodischer Auftrag (Speicher gehört dem Aufrufer)
+typedef struct ZeitplanAuftrag {
+    const char* name;
+    ZeitplanFunktion funktion;
+    void* kontext;
+    int intervall_ms;
+    int toleranz_ms;                // Erlaubte Verspätung zum Bündeln
+
+    // Verwaltung durch den Zeitplaner
+    long long frist_ms;             // Soll-Zeitpunkt der nächsten Ausführung
+    uint64_t ablauf_tick;           // Fach im Zeitrad (Frist, auf Raster gerundet)
+    struct ZeitplanAuftrag* naechster;
+    struct ZeitplanAuftrag** vorgaenger; // Verweis auf den Zeiger auf diesen Auftrag
+
+    // Zähler
+    unsigned long ausfuehrungen;
+    unsigned long verpasst;         // Ausgelassene Intervalle (Schleife hing)
+    unsigned long fristverletzungen; // Start später als Frist + Toleranz + 1 Tick
+    LatenzHistogramm verspaetung;   // Tatsächlicher gegenüber geplantem Start
+    LatenzHistogramm laufzeit;      // Ausführungsdauer der Funktion
+} ZeitplanAuftrag;
+
+// Zähler des Zeitplaners
+typedef struct {
+    unsigned long eingeplant;       // Einfügungen ins Zeitrad
+    unsigned long ausfuehrungen;
+    unsigned long umsortiert;       // Aufträge, die eine Ebene tiefer wanderten
+    unsigned long ticks;            // Abgearbeitete Ticks
+    unsigned long fristverletzungen; // Summe über alle Aufträge
+} ZeitplanStatistik;
+
+// Auflösung und Aufbau des Zeitrads
+#define ZEITPLAN_TICK_MS 10
+#define ZEITPLAN_EBENEN 4
+#define ZEITPLAN_FACH_BITS 6
+#define ZEITPLAN_FAECHER (1 << ZEITPLAN_FACH_BITS)
+
+// Funktionsdeklarationen
+
+/**
+ * Setzt den Zeitplaner zurück (Zeitbasis: CLOCK_MONOTONIC)
+ */
+void zeitplan_initialisieren(void);
+
+/**
+ * Plant einen periodischen Auftrag ein
+ * @param auftrag Auftrag (bleibt bis zum Entfernen gültig)
+ * @param name Name für Statistik und Ausgabe
+ * @param erster_ms Verzögerung bis zur ersten Ausführung (0 = im nächsten Durchlauf)
+ * @param intervall_ms Abstand der Ausführungen
+ * @param toleranz_ms Erlaubte Verspätung, um Aufträge zu bündeln
+ * @param funktion Auszuführende Funktion
+ * @param kontext Wird an die Funktion übergeben
+ */
+void zeitplan_einplanen(ZeitplanAuftrag* auftrag, const char* name,
+                        int erster_ms, int intervall_ms, int toleranz_ms,
+                        ZeitplanFunktion funktion, void* kontext);
+
+/**
+ * Nimmt einen Auftrag aus dem Zeitrad
+ * @param auftrag Auftrag
+ */
+void zeitplan_entfernen(ZeitplanAuftrag* auftrag);
+
+/**
+ * Führt alle fälligen Aufträge aus und plant sie neu ein
+ * @return Anzahl ausgeführter Aufträge
+ */
+int zeitplan_abarbeiten(void);
+
+/**
+ * Zeit bis zum nächsten möglichen Ablauf
+ * Liegt der nächste Auftrag auf einer höheren Ebene, ist das Ergebnis der
+ * Zeitpunkt, an dem er eine Ebene tiefer wandert (nie später als seine Frist).
+ * @param maximum Obergrenze in Millisekunden
+ * @return Wartezeit in Millisekunden (0 = sofort)
+ */
+int zeitplan_wartezeit_ms(int maximum);
+
+/**
+ * Setzt die Latenz-Histogramme und Fristverletzungen eines Auftrags zurück
+ * @param auftrag Auftrag
+ */
+void zeitplan_latenz_zuruecksetzen(ZeitplanAuftrag* auftrag);
+
+/**
+ * Liefert die Zähler des Zeitplaners
+ * @param statistik Ziel-Struktur
+ */
+void zeitplan_statistik_abfragen(ZeitplanStatistik* statistik);
+
+#endif // ZEITPLAN_H